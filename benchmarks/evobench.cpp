@@ -0,0 +1,1029 @@
+/*
+    Evocosm is a C++ framework for implementing evolutionary algorithms.
+
+    Copyright 2011 Scott Robert Ladd. All rights reserved.
+
+    Evocosm is user-supported open source software. Its continued development is dependent
+    on financial support from the community. You can provide funding by visiting the Evocosm
+    website at:
+
+        http://www.coyotegulch.com
+
+    You may license Evocosm in one of two fashions:
+
+    1) Simplified BSD License (FreeBSD License)
+
+    Redistribution and use in source and binary forms, with or without modification, are
+    permitted provided that the following conditions are met:
+
+    1.  Redistributions of source code must retain the above copyright notice, this list of
+        conditions and the following disclaimer.
+
+    2.  Redistributions in binary form must reproduce the above copyright notice, this list
+        of conditions and the following disclaimer in the documentation and/or other materials
+        provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY SCOTT ROBERT LADD ``AS IS'' AND ANY EXPRESS OR IMPLIED
+    WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+    FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SCOTT ROBERT LADD OR
+    CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+    ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+    The views and conclusions contained in the software and documentation are those of the
+    authors and should not be interpreted as representing official policies, either expressed
+    or implied, of Scott Robert Ladd.
+
+    2) Closed-Source Proprietary License
+
+    If your project is a closed-source or proprietary project, the Simplified BSD License may
+    not be appropriate or desirable. In such cases, contact the Evocosm copyright holder to
+    arrange your purchase of an appropriate license.
+
+    The author can be contacted at:
+
+          scott.ladd@coyotegulch.com
+          scott.ladd@gmail.com
+          http:www.coyotegulch.com
+*/
+
+// Standard C++
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+using namespace std;
+
+// libevocosm
+#include "../libevocosm/evocosm.h"
+#include "../libevocosm/function_optimizer.h"
+#include "../libevocosm/fixed_function_optimizer.h"
+#include "../libevocosm/simple_machine.h"
+#include "../libevocosm/fuzzy_machine.h"
+#include "../libevocosm/state_machine.h"
+#include "../libevocosm/evoreal.h"
+#include "../libevocosm/stats.h"
+#include "../libevocosm/population.h"
+#include "../libevocosm/genome_pool.h"
+using namespace libevocosm;
+
+//---------------------------------------------------------------------------
+// Components for whole-generation benchmarks, mirroring the example programs
+//---------------------------------------------------------------------------
+
+// the function from examples/function_optimization
+vector<double> fopt_test(vector<double> p_args)
+{
+    double z = 0.0;
+
+    if (p_args.size() == 2)
+    {
+        double x = p_args[0];
+        double y = p_args[1];
+
+        if ((x <= 1.0) && (x >= -1.0) && (y <= 1.0) && (y >= -1.0))
+        {
+            z = 0.8 + pow(x + 0.5, 2.0) + 2.0 * pow(y - 0.5, 2.0) - 0.3 * cos(3.0 * BRAHE_PI * x) - 0.4 * cos(4.0 * BRAHE_PI * y);
+
+            if (errno != 0)
+            {
+                z = 0.0;
+                errno = 0;
+            }
+        }
+    }
+
+    vector<double> result;
+
+    result.push_back(z);
+    result.push_back((z != 0) ? (1.0 / z) : 0.0);
+
+    return result;
+}
+
+// the same function with its arguments and result stored inline
+std::array<double,2> fopt_fixed_test(const std::array<double,2> & p_args)
+{
+    double x = p_args[0];
+    double y = p_args[1];
+    double z = 0.0;
+
+    if ((x <= 1.0) && (x >= -1.0) && (y <= 1.0) && (y >= -1.0))
+    {
+        z = 0.8 + pow(x + 0.5, 2.0) + 2.0 * pow(y - 0.5, 2.0) - 0.3 * cos(3.0 * BRAHE_PI * x) - 0.4 * cos(4.0 * BRAHE_PI * y);
+
+        if (errno != 0)
+        {
+            z = 0.0;
+            errno = 0;
+        }
+    }
+
+    std::array<double,2> result = {{ z, (z != 0) ? (1.0 / z) : 0.0 }};
+    return result;
+}
+
+// strategies from examples/prisoners_dilemma
+typedef organism< simple_machine<2,2> > pdsm_strategy;
+
+class pdsm_mutator : public mutator<pdsm_strategy>
+{
+public:
+    pdsm_mutator(double a_mutation_rate)
+        : m_mutation_rate(a_mutation_rate)
+    {
+        // nada
+    }
+
+    void mutate(vector<pdsm_strategy> & a_population)
+    {
+        for (size_t i = 0; i < a_population.size(); ++i)
+            a_population[i].genes.mutate(m_mutation_rate);
+    }
+
+private:
+    double m_mutation_rate;
+};
+
+class pdsm_reproducer : public reproducer<pdsm_strategy>
+{
+public:
+    using reproducer<pdsm_strategy>::breed;
+
+    virtual bool breed(const vector<pdsm_strategy> & a_population, size_t a_limit, vector<pdsm_strategy> & a_children)
+    {
+        vector<double> wheel_weights;
+
+        for (size_t i = 0; i < a_population.size(); ++i)
+            wheel_weights.push_back(a_population[i].fitness > 0.0 ? a_population[i].fitness : 0.0);
+
+        alias_roulette_wheel fitness_wheel(wheel_weights);
+
+        while (a_limit > 0)
+        {
+            size_t p1 = fitness_wheel.get_index();
+            size_t p2 = p1;
+
+            while (p2 == p1)
+                p2 = fitness_wheel.get_index();
+
+            a_children.push_back(pdsm_strategy(simple_machine<2,2>(a_population[p1].genes, a_population[p2].genes)));
+
+            --a_limit;
+        }
+
+        return true;
+    }
+};
+
+class pdsm_landscape : public landscape<pdsm_strategy>
+{
+public:
+    pdsm_landscape(listener<pdsm_strategy> & a_listener, size_t a_rounds)
+        : landscape<pdsm_strategy>(a_listener),
+          m_rounds(a_rounds)
+    {
+        // nada
+    }
+
+    virtual double test(pdsm_strategy & a_organism, bool a_verbose = false) const
+    {
+        return a_organism.fitness;
+    }
+
+    virtual double test(vector<pdsm_strategy> & a_population) const
+    {
+        static const double payout[2][2] = { { 3.0, 0.0 }, { 5.0, 1.0 } };
+
+        for (size_t red = 0; red < a_population.size(); ++red)
+        {
+            a_population[red].reset();
+
+            for (size_t blue = 0; blue < a_population.size(); ++blue)
+            {
+                if (red != blue)
+                {
+                    a_population[red].genes.reset();
+                    a_population[blue].genes.reset();
+
+                    size_t prev_red_move  = 0;
+                    size_t prev_blue_move = 0;
+
+                    for (size_t round = 0; round < m_rounds; ++round)
+                    {
+                        size_t red_move  = a_population[red].genes.transition(prev_blue_move);
+                        size_t blue_move = a_population[blue].genes.transition(prev_red_move);
+
+                        a_population[red].fitness += payout[red_move][blue_move];
+
+                        prev_red_move  = red_move;
+                        prev_blue_move = blue_move;
+                    }
+                }
+            }
+
+            a_population[red].fitness /= static_cast<double>((a_population.size() - 1) * m_rounds);
+        }
+
+        return 0.0;
+    }
+
+private:
+    size_t m_rounds;
+};
+
+//---------------------------------------------------------------------------
+// Measurement
+//---------------------------------------------------------------------------
+
+// one benchmark's result
+struct bench_result
+{
+    string m_group;
+    string m_name;
+    size_t m_size;
+    size_t m_iterations;
+    double m_ns_per_op;
+    double m_min_ns_per_op;
+};
+
+// defeats dead-code elimination of benchmarked operations
+static volatile double g_sink = 0.0;
+
+class bench_suite : protected globals
+{
+public:
+    bench_suite(double a_min_time, const string & a_filter, bool a_quick)
+      : m_min_time(a_min_time),
+        m_filter(a_filter),
+        m_quick(a_quick),
+        m_results()
+    {
+        // nada
+    }
+
+    const vector<bench_result> & results() const
+    {
+        return m_results;
+    }
+
+    void run_all()
+    {
+        bench_roulette();
+        bench_stats();
+        bench_organisms();
+        bench_scalers();
+        bench_selectors();
+        bench_simple_machine();
+        bench_fuzzy_machine();
+        bench_state_machine();
+        bench_evoreal();
+        bench_fopt_generation();
+        bench_pdsm_generation();
+    }
+
+private:
+    // number of timed samples per benchmark; the median is reported
+    static const int SAMPLES = 5;
+
+    // the same random sequence for every run
+    static const uint32_t SEED = 8675309;
+
+    // problem sizes; quick runs use only the first
+    vector<size_t> sizes(size_t a_small, size_t a_medium, size_t a_large) const
+    {
+        vector<size_t> result;
+
+        result.push_back(a_small);
+
+        if (!m_quick)
+        {
+            result.push_back(a_medium);
+            result.push_back(a_large);
+        }
+
+        return result;
+    }
+
+    // should a benchmark run?
+    bool selected(const char * a_group, const char * a_name) const
+    {
+        string id = string(a_group) + "/" + a_name;
+        return m_filter.empty() || (id.find(m_filter) != string::npos);
+    }
+
+    // time a number of calls to an operation
+    template <class Operation>
+    static double time_ops(Operation & a_op, size_t a_iterations)
+    {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+        for (size_t n = 0; n < a_iterations; ++n)
+            a_op();
+
+        return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+
+    // calibrate, sample and record one benchmark
+    template <class Operation>
+    void measure(const char * a_group, const char * a_name, size_t a_size, Operation a_op)
+    {
+        // double the iterations until a sample takes long enough to time reliably
+        size_t iterations = 1;
+
+        while ((time_ops(a_op, iterations) < m_min_time) && (iterations < (size_t(1) << 30)))
+            iterations *= 2;
+
+        vector<double> samples;
+
+        for (int s = 0; s < SAMPLES; ++s)
+            samples.push_back(time_ops(a_op, iterations) * 1.0e9 / (double)iterations);
+
+        sort(samples.begin(), samples.end());
+
+        bench_result result;
+        result.m_group         = a_group;
+        result.m_name          = a_name;
+        result.m_size          = a_size;
+        result.m_iterations    = iterations;
+        result.m_ns_per_op     = samples[SAMPLES / 2];
+        result.m_min_ns_per_op = samples[0];
+        m_results.push_back(result);
+
+        cerr << setw(12) << left << a_group << setw(24) << a_name << setw(8) << right << a_size
+             << setw(16) << fixed << setprecision(1) << result.m_ns_per_op << " ns/op" << endl;
+    }
+
+    // random fitness values in (0,1]
+    vector<double> random_weights(size_t a_size)
+    {
+        vector<double> result;
+
+        for (size_t n = 0; n < a_size; ++n)
+            result.push_back(1.0 - g_random.get_real());
+
+        return result;
+    }
+
+    // a population of function_solutions with random fitness
+    vector<function_solution> function_population(size_t a_size)
+    {
+        vector<function_solution> result;
+
+        for (size_t n = 0; n < a_size; ++n)
+        {
+            result.push_back(function_solution(2, -1.0, 1.0));
+            result.back().fitness = 1.0 - g_random.get_real();
+        }
+
+        return result;
+    }
+
+    void bench_roulette()
+    {
+        vector<size_t> ns = sizes(16, 1024, 65536);
+
+        for (size_t i = 0; i < ns.size(); ++i)
+        {
+            set_seed(SEED);
+            vector<double> weights = random_weights(ns[i]);
+
+            if (selected("roulette", "construct"))
+                measure("roulette", "construct", ns[i], [&]() { roulette_wheel wheel(weights); g_sink = g_sink + wheel.get_size(); });
+
+            if (selected("roulette", "get_index"))
+            {
+                roulette_wheel wheel(weights);
+                measure("roulette", "get_index", ns[i], [&]() { g_sink = g_sink + wheel.get_index(); });
+            }
+
+            if (selected("roulette", "sample"))
+            {
+                roulette_wheel wheel(weights);
+                vector<size_t> indexes;
+                measure("roulette", "sample", ns[i], [&]() { wheel.sample(weights.size(), indexes); g_sink = g_sink + indexes.back(); });
+            }
+
+            if (selected("roulette", "alias_construct"))
+                measure("roulette", "alias_construct", ns[i], [&]() { alias_roulette_wheel wheel(weights); g_sink = g_sink + wheel.get_size(); });
+
+            if (selected("roulette", "alias_get_index"))
+            {
+                alias_roulette_wheel wheel(weights);
+                measure("roulette", "alias_get_index", ns[i], [&]() { g_sink = g_sink + wheel.get_index(); });
+            }
+
+            if (selected("roulette", "fenwick_get_index"))
+            {
+                fenwick_roulette_wheel wheel(weights);
+                measure("roulette", "fenwick_get_index", ns[i], [&]() { g_sink = g_sink + wheel.get_index(); });
+            }
+
+            if (selected("roulette", "set_weight"))
+            {
+                roulette_wheel wheel(weights);
+                size_t n = 0;
+                measure("roulette", "set_weight", ns[i], [&]() { g_sink = g_sink + wheel.set_weight(n, weights[n]); n = (n + 1) % weights.size(); });
+            }
+
+            if (selected("roulette", "fenwick_set_weight"))
+            {
+                fenwick_roulette_wheel wheel(weights);
+                size_t n = 0;
+                measure("roulette", "fenwick_set_weight", ns[i], [&]() { g_sink = g_sink + wheel.set_weight(n, weights[n]); n = (n + 1) % weights.size(); });
+            }
+        }
+    }
+
+    void bench_stats()
+    {
+        vector<size_t> ns = sizes(100, 1000, 10000);
+
+        for (size_t i = 0; i < ns.size(); ++i)
+        {
+            if (!selected("stats", "fitness_stats"))
+                continue;
+
+            set_seed(SEED);
+            vector<function_solution> population = function_population(ns[i]);
+
+            measure("stats", "fitness_stats", ns[i], [&]() { fitness_stats<function_solution> stats(population); g_sink = g_sink + stats.getMean(); });
+        }
+
+        for (size_t i = 0; i < ns.size(); ++i)
+        {
+            if (!selected("stats", "fitness_stats_soa"))
+                continue;
+
+            set_seed(SEED);
+            soa_population<function_solution> population(function_population(ns[i]));
+
+            measure("stats", "fitness_stats_soa", ns[i], [&]() { fitness_stats<function_solution> stats(population.get_fitness()); g_sink = g_sink + stats.getMean(); });
+        }
+    }
+
+    // copies and sorts a population of fixed-size genomes
+    template <class OrganismType>
+    void bench_organism(const char * a_kind, size_t a_size)
+    {
+        vector<OrganismType> population(a_size);
+
+        for (size_t n = 0; n < a_size; ++n)
+        {
+            for (size_t g = 0; g < population[n].genes.size(); ++g)
+                population[n].genes[g] = g_random.get_real();
+
+            population[n].fitness = g_random.get_real();
+        }
+
+        vector<OrganismType> copy(population);
+        string copy_name = string(a_kind) + "_copy";
+        string sort_name = string(a_kind) + "_sort";
+
+        if (selected("organism", copy_name.c_str()))
+            measure("organism", copy_name.c_str(), a_size, [&]() { copy = population; g_sink = g_sink + copy[0].fitness; });
+
+        if (selected("organism", sort_name.c_str()))
+            measure("organism", sort_name.c_str(), a_size, [&]() { copy = population; sort(copy.begin(), copy.end()); g_sink = g_sink + copy[0].fitness; });
+    }
+
+    void bench_organisms()
+    {
+        vector<size_t> ns = sizes(1000, 10000, 100000);
+
+        for (size_t i = 0; i < ns.size(); ++i)
+        {
+            set_seed(SEED);
+            bench_organism< organism< array<double,4> > >("organism", ns[i]);
+
+            set_seed(SEED);
+            bench_organism< compact_organism< array<double,4> > >("compact", ns[i]);
+        }
+    }
+
+    // scales a population, restoring its fitness before each call, and then
+    // the fitness array of the same population stored as a soa_population
+    void bench_scaler(const char * a_name, scaler<function_solution> & a_scaler, size_t a_size)
+    {
+        set_seed(SEED);
+        vector<function_solution> population = function_population(a_size);
+        vector<double> fitness(a_size);
+
+        for (size_t n = 0; n < a_size; ++n)
+            fitness[n] = population[n].fitness;
+
+        if (selected("scaler", a_name))
+        {
+            measure("scaler", a_name, a_size, [&]()
+            {
+                for (size_t n = 0; n < population.size(); ++n)
+                    population[n].fitness = fitness[n];
+
+                a_scaler.scale_fitness(population);
+                g_sink = g_sink + population[0].fitness;
+            });
+        }
+
+        string soa_name = string(a_name) + "_soa";
+
+        if (selected("scaler", soa_name.c_str()))
+        {
+            soa_population<function_solution> soa(population);
+
+            measure("scaler", soa_name.c_str(), a_size, [&]()
+            {
+                soa.get_fitness() = fitness;
+                a_scaler.scale_fitness(soa.get_fitness());
+                g_sink = g_sink + soa.fitness(0);
+            });
+        }
+    }
+
+    void bench_scalers()
+    {
+        vector<size_t> ns = sizes(100, 1000, 10000);
+
+        for (size_t i = 0; i < ns.size(); ++i)
+        {
+            // the baseline only restores fitness; subtract it from the others
+            null_scaler<function_solution>        null;
+            linear_norm_scaler<function_solution> linear_norm;
+            windowed_scaler<function_solution>    windowed;
+            exponential_scaler<function_solution> exponential;
+            quadratic_scaler<function_solution>   quadratic(1.0, 1.0, 1.0);
+            sigma_scaler<function_solution>       sigma;
+
+            bench_scaler("null", null, ns[i]);
+            bench_scaler("linear_norm", linear_norm, ns[i]);
+            bench_scaler("windowed", windowed, ns[i]);
+            bench_scaler("exponential", exponential, ns[i]);
+            bench_scaler("quadratic", quadratic, ns[i]);
+            bench_scaler("sigma", sigma, ns[i]);
+        }
+    }
+
+    // transition, mutation and crossover for a machine with a given number of states
+    template <class Machine, class Factory, class Mutate>
+    void bench_machine(const char * a_group, size_t a_states, Factory a_factory, Mutate a_mutate)
+    {
+        set_seed(SEED);
+
+        Machine parent1 = a_factory(a_states);
+        Machine parent2 = a_factory(a_states);
+
+        if (selected(a_group, "transition"))
+        {
+            Machine machine(parent1);
+            size_t input = 0;
+            measure(a_group, "transition", a_states, [&]() { input = (size_t)machine.transition(input) & 1; g_sink = g_sink + input; });
+        }
+
+        if (selected(a_group, "mutate"))
+        {
+            Machine machine(parent1);
+            measure(a_group, "mutate", a_states, [&]() { a_mutate(machine); });
+        }
+
+        if (selected(a_group, "crossover"))
+            measure(a_group, "crossover", a_states, [&]() { Machine child(parent1, parent2); g_sink = g_sink + 1.0; });
+
+        if (selected(a_group, "copy"))
+            measure(a_group, "copy", a_states, [&]() { Machine child(parent1); g_sink = g_sink + 1.0; });
+    }
+
+    // selects survivors by index, from a population and from its fitness array
+    void bench_selector(const char * a_name, selector<function_solution> & a_selector, size_t a_size)
+    {
+        set_seed(SEED);
+        vector<function_solution> population = function_population(a_size);
+        vector<size_t> survivors;
+
+        if (selected("selector", a_name))
+        {
+            measure("selector", a_name, a_size, [&]()
+            {
+                a_selector.select_survivors(population, survivors);
+                g_sink = g_sink + double(survivors.size());
+            });
+        }
+
+        string soa_name = string(a_name) + "_soa";
+
+        if (selected("selector", soa_name.c_str()))
+        {
+            soa_population<function_solution> soa(population);
+
+            measure("selector", soa_name.c_str(), a_size, [&]()
+            {
+                a_selector.select_survivors(soa.get_fitness(), survivors);
+                g_sink = g_sink + double(survivors.size());
+            });
+        }
+    }
+
+    void bench_selectors()
+    {
+        vector<size_t> ns = sizes(100, 10000, 1000000);
+
+        for (size_t i = 0; i < ns.size(); ++i)
+        {
+            // about a tenth of the population, in every case
+            elitism_selector<function_solution>    elitism(0.9);
+            top_k_selector<function_solution>      top_k(ns[i] / 10);
+            tournament_selector<function_solution> tournament(ns[i] / 10, 2);
+
+            bench_selector("elitism", elitism, ns[i]);
+            bench_selector("top_k", top_k, ns[i]);
+            bench_selector("tournament", tournament, ns[i]);
+        }
+    }
+
+    void bench_simple_machine()
+    {
+        vector<size_t> ns = sizes(4, 32, 256);
+
+        for (size_t i = 0; i < ns.size(); ++i)
+        {
+            bench_machine< simple_machine<2,2> >("simple_fsm", ns[i],
+                [](size_t a_states) { return simple_machine<2,2>(a_states); },
+                [](simple_machine<2,2> & a_machine) { a_machine.mutate(0.25); });
+
+            // the same, recycling tables through the genome pool
+            genome_pool::set_enabled(true);
+
+            bench_machine< simple_machine<2,2> >("pooled_fsm", ns[i],
+                [](size_t a_states) { return simple_machine<2,2>(a_states); },
+                [](simple_machine<2,2> & a_machine) { a_machine.mutate(0.25); });
+
+            genome_pool::set_enabled(false);
+            genome_pool::trim();
+        }
+    }
+
+    void bench_fuzzy_machine()
+    {
+        vector<size_t> ns = sizes(4, 32, 256);
+
+        for (size_t i = 0; i < ns.size(); ++i)
+        {
+            bench_machine< fuzzy_machine<2,2> >("fuzzy_fsm", ns[i],
+                [](size_t a_states) { return fuzzy_machine<2,2>(a_states); },
+                [](fuzzy_machine<2,2> & a_machine) { a_machine.mutate(0.25); });
+        }
+    }
+
+    void bench_state_machine()
+    {
+        vector<size_t> ns = sizes(4, 32, 256);
+
+        vector<size_t> symbols;
+        symbols.push_back(0);
+        symbols.push_back(1);
+
+        for (size_t i = 0; i < ns.size(); ++i)
+        {
+            bench_machine< state_machine<size_t,size_t> >("state_fsm", ns[i],
+                [&](size_t a_states) { return state_machine<size_t,size_t>(a_states, symbols, symbols); },
+                [&](state_machine<size_t,size_t> & a_machine) { a_machine.mutate(0.25, symbols, symbols); });
+        }
+    }
+
+    void bench_evoreal()
+    {
+        static const size_t NUM_VALUES = 1024;
+
+        set_seed(SEED);
+
+        vector<double> values;
+
+        for (size_t n = 0; n < NUM_VALUES; ++n)
+            values.push_back(g_random.get_real() * 200.0 - 100.0);
+
+        evoreal tool;
+        size_t index = 0;
+
+        if (selected("evoreal", "mutate"))
+            measure("evoreal", "mutate", 1, [&]() { g_sink = g_sink + tool.mutate(values[index]); index = (index + 1) % NUM_VALUES; });
+
+        if (selected("evoreal", "crossover"))
+            measure("evoreal", "crossover", 1, [&]() { g_sink = g_sink + tool.crossover(values[index], values[(index + 1) % NUM_VALUES]); index = (index + 1) % NUM_VALUES; });
+    }
+
+    // one generation of the function optimization example
+    void bench_fopt_generation()
+    {
+        vector<size_t> ns = sizes(100, 1000, 10000);
+
+        for (size_t i = 0; i < ns.size(); ++i)
+        {
+            if (!selected("generation", "fopt"))
+                continue;
+
+            set_seed(SEED);
+
+            null_listener<function_solution>  listener;
+            vector<function_solution>         population;
+            function_landscape                landscape(&fopt_test, listener);
+            function_mutator                  mutator(0.25);
+            function_reproducer               reproducer(0.9);
+            linear_norm_scaler<function_solution> scaler(10.0);
+            elitism_selector<function_solution>   selector(0.9);
+            analyzer<function_solution>       analyzer(listener);
+
+            for (size_t n = 0; n < ns[i]; ++n)
+                population.push_back(function_solution(2, -1.0, 1.0));
+
+            evocosm<function_solution> cosm(population, landscape, mutator, reproducer, scaler, selector, analyzer, listener);
+
+            measure("generation", "fopt", ns[i], [&]() { cosm.run_generation(); });
+        }
+
+        // the fopt generation again, scaling and selecting on a separate fitness array
+        for (size_t i = 0; i < ns.size(); ++i)
+        {
+            if (!selected("generation", "fopt_soa"))
+                continue;
+
+            set_seed(SEED);
+
+            null_listener<function_solution>  listener;
+            vector<function_solution>         population;
+            function_landscape                landscape(&fopt_test, listener);
+            function_mutator                  mutator(0.25);
+            function_reproducer               reproducer(0.9);
+            linear_norm_scaler<function_solution> scaler(10.0);
+            elitism_selector<function_solution>   selector(0.9);
+            analyzer<function_solution>       analyzer(listener);
+
+            for (size_t n = 0; n < ns[i]; ++n)
+                population.push_back(function_solution(2, -1.0, 1.0));
+
+            evocosm<function_solution> cosm(population, landscape, mutator, reproducer, scaler, selector, analyzer, listener);
+            cosm.set_fitness_apart(true);
+
+            measure("generation", "fopt_soa", ns[i], [&]() { cosm.run_generation(); });
+        }
+
+        // the same with tournaments, which need neither scaling nor a wheel
+        for (size_t i = 0; i < ns.size(); ++i)
+        {
+            if (!selected("generation", "fopt_tournament"))
+                continue;
+
+            set_seed(SEED);
+
+            null_listener<function_solution>       listener;
+            vector<function_solution>              population;
+            function_landscape                     landscape(&fopt_test, listener);
+            function_mutator                       mutator(0.25);
+            function_tournament_reproducer         reproducer(0.9, 2);
+            null_scaler<function_solution>         scaler;
+            tournament_selector<function_solution> selector(ns[i] / 10, 2);
+            analyzer<function_solution>            analyzer(listener);
+
+            for (size_t n = 0; n < ns[i]; ++n)
+                population.push_back(function_solution(2, -1.0, 1.0));
+
+            evocosm<function_solution> cosm(population, landscape, mutator, reproducer, scaler, selector, analyzer, listener);
+
+            measure("generation", "fopt_tournament", ns[i], [&]() { cosm.run_generation(); });
+        }
+
+        // tournaments again, breeding and mutating on every available thread
+        for (size_t i = 0; i < ns.size(); ++i)
+        {
+            if (!selected("generation", "fopt_parallel"))
+                continue;
+
+            set_seed(SEED);
+
+            null_listener<function_solution>       listener;
+            vector<function_solution>              population;
+            function_landscape                     landscape(&fopt_test, listener);
+            function_mutator                       mutator(0.25);
+            function_tournament_reproducer         reproducer(0.9, 2);
+            null_scaler<function_solution>         scaler;
+            tournament_selector<function_solution> selector(ns[i] / 10, 2);
+            analyzer<function_solution>            analyzer(listener);
+
+            for (size_t n = 0; n < ns[i]; ++n)
+                population.push_back(function_solution(2, -1.0, 1.0));
+
+            evocosm<function_solution> cosm(population, landscape, mutator, reproducer, scaler, selector, analyzer, listener);
+            cosm.set_num_threads(0);
+            cosm.set_breed_threads(0);
+
+            measure("generation", "fopt_parallel", ns[i], [&]() { cosm.run_generation(); });
+        }
+
+        // the fopt generation again, with two arguments stored inline
+        for (size_t i = 0; i < ns.size(); ++i)
+        {
+            if (!selected("generation", "fopt_fixed"))
+                continue;
+
+            set_seed(SEED);
+
+            typedef fixed_function_solution<2> fixed_solution;
+
+            null_listener<fixed_solution>      listener;
+            vector<fixed_solution>             population;
+            fixed_function_landscape<2>        landscape(&fopt_fixed_test, listener);
+            fixed_function_mutator<2>          mutator(0.25);
+            fixed_function_reproducer<2>       reproducer(0.9);
+            linear_norm_scaler<fixed_solution> scaler(10.0);
+            elitism_selector<fixed_solution>   selector(0.9);
+            analyzer<fixed_solution>           analyzer(listener);
+
+            for (size_t n = 0; n < ns[i]; ++n)
+                population.push_back(fixed_solution(-1.0, 1.0));
+
+            evocosm<fixed_solution> cosm(population, landscape, mutator, reproducer, scaler, selector, analyzer, listener);
+
+            measure("generation", "fopt_fixed", ns[i], [&]() { cosm.run_generation(); });
+        }
+    }
+
+    // one generation of the prisoner's dilemma example
+    void bench_pdsm_generation()
+    {
+        vector<size_t> ns = sizes(50, 200, 500);
+
+        for (size_t i = 0; i < ns.size(); ++i)
+        {
+            bench_pdsm("pdsm", ns[i], false);
+
+            // the same, recycling machine tables through the genome pool
+            bench_pdsm("pdsm_pool", ns[i], true);
+        }
+    }
+
+    void bench_pdsm(const char * a_name, size_t a_size, bool a_pooled)
+    {
+        if (!selected("generation", a_name))
+            return;
+
+        set_seed(SEED);
+        genome_pool::set_enabled(a_pooled);
+
+        {
+            null_listener<pdsm_strategy>      listener;
+            vector<pdsm_strategy>             population;
+            pdsm_landscape                    landscape(listener, 20);
+            pdsm_mutator                      mutator(0.25);
+            pdsm_reproducer                   reproducer;
+            linear_norm_scaler<pdsm_strategy> scaler;
+            elitism_selector<pdsm_strategy>   selector(0.5);
+            analyzer<pdsm_strategy>           analyzer(listener);
+
+            for (size_t n = 0; n < a_size; ++n)
+                population.push_back(pdsm_strategy(simple_machine<2,2>(4)));
+
+            evocosm<pdsm_strategy> cosm(population, landscape, mutator, reproducer, scaler, selector, analyzer, listener);
+
+            measure("generation", a_name, a_size, [&]() { cosm.run_generation(); });
+        }
+
+        genome_pool::set_enabled(false);
+        genome_pool::trim();
+    }
+
+    // minimum time for a timed sample, in seconds
+    double m_min_time;
+
+    // substring identifying benchmarks to run
+    string m_filter;
+
+    // only run the smallest size of each benchmark
+    bool m_quick;
+
+    // results collected so far
+    vector<bench_result> m_results;
+};
+
+//---------------------------------------------------------------------------
+// Output
+//---------------------------------------------------------------------------
+
+void write_csv(ostream & a_stream, const vector<bench_result> & a_results)
+{
+    a_stream << "group,name,size,iterations,ns_per_op,min_ns_per_op" << endl;
+
+    for (size_t n = 0; n < a_results.size(); ++n)
+    {
+        const bench_result & r = a_results[n];
+
+        a_stream << r.m_group << "," << r.m_name << "," << r.m_size << "," << r.m_iterations << ","
+                 << fixed << setprecision(3) << r.m_ns_per_op << "," << r.m_min_ns_per_op << endl;
+    }
+}
+
+void write_json(ostream & a_stream, const vector<bench_result> & a_results, const string & a_version)
+{
+    a_stream << "{\n  \"library\": \"evocosm\",\n  \"version\": \"" << a_version << "\",\n  \"results\": [";
+
+    for (size_t n = 0; n < a_results.size(); ++n)
+    {
+        const bench_result & r = a_results[n];
+
+        a_stream << ((n == 0) ? "\n" : ",\n")
+                 << "    { \"group\": \"" << r.m_group << "\", \"name\": \"" << r.m_name
+                 << "\", \"size\": " << r.m_size << ", \"iterations\": " << r.m_iterations
+                 << fixed << setprecision(3)
+                 << ", \"ns_per_op\": " << r.m_ns_per_op << ", \"min_ns_per_op\": " << r.m_min_ns_per_op << " }";
+    }
+
+    a_stream << "\n  ]\n}" << endl;
+}
+
+// makes the version available outside of globals
+class version_reader : protected globals
+{
+public:
+    static string get()
+    {
+        return version();
+    }
+};
+
+void usage()
+{
+    cerr << "usage: evobench [--format=csv|json] [--output=FILE] [--filter=TEXT] [--min-time=SECONDS] [--quick]\n"
+         << "  --format    result format written to standard output or FILE (default csv)\n"
+         << "  --output    write results to FILE instead of standard output\n"
+         << "  --filter    only run benchmarks whose group/name contains TEXT\n"
+         << "  --min-time  minimum duration of each timed sample (default 0.05)\n"
+         << "  --quick     only run the smallest size of each benchmark" << endl;
+}
+
+int main(int argc, char * argv[])
+{
+    string format   = "csv";
+    string output;
+    string filter;
+    double min_time = 0.05;
+    bool   quick    = false;
+
+    for (int n = 1; n < argc; ++n)
+    {
+        string arg(argv[n]);
+
+        if (arg.compare(0, 9, "--format=") == 0)
+            format = arg.substr(9);
+        else if (arg.compare(0, 9, "--output=") == 0)
+            output = arg.substr(9);
+        else if (arg.compare(0, 9, "--filter=") == 0)
+            filter = arg.substr(9);
+        else if (arg.compare(0, 11, "--min-time=") == 0)
+            min_time = atof(arg.substr(11).c_str());
+        else if (arg == "--quick")
+            quick = true;
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+
+    if ((format != "csv") && (format != "json"))
+    {
+        usage();
+        return 1;
+    }
+
+    bench_suite suite(min_time, filter, quick);
+    suite.run_all();
+
+    ofstream file;
+
+    if (!output.empty())
+    {
+        file.open(output.c_str());
+
+        if (!file)
+        {
+            cerr << "evobench: cannot write " << output << endl;
+            return 1;
+        }
+    }
+
+    ostream & stream = output.empty() ? cout : file;
+
+    if (format == "json")
+        write_json(stream, suite.results(), version_reader::get());
+    else
+        write_csv(stream, suite.results());
+
+    return 0;
+}
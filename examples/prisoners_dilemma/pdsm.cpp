@@ -173,7 +173,9 @@ public:
         return m_crossover_rate;
     }
 
-    virtual vector<pdsm_strategy> breed(const vector<pdsm_strategy> & a_population, size_t a_limit)
+    using reproducer<pdsm_strategy>::breed;
+
+    virtual bool breed(const vector<pdsm_strategy> & a_population, size_t a_limit, vector<pdsm_strategy> & a_children)
     {
         // construct a fitness wheel
         vector<double> wheel_weights;
@@ -181,10 +183,10 @@ public:
         for (int i = 0; i < a_population.size(); ++i)
             wheel_weights.push_back(a_population[i].fitness > 0.0 ? a_population[i].fitness : 0.0);
 
-        roulette_wheel fitness_wheel(wheel_weights);
+        alias_roulette_wheel fitness_wheel(wheel_weights);
 
-        // create children
-        vector<pdsm_strategy> children;
+        // create children, which are moved into place
+        a_children.reserve(a_children.size() + a_limit);
 
         while (a_limit > 0)
         {
@@ -200,17 +202,17 @@ public:
                 while (p2 == p1)
                     p2 = fitness_wheel.get_index();
 
-                children.push_back(pdsm_strategy(simple_machine<2,2>(a_population[p1].genes, a_population[p2].genes)));
+                a_children.push_back(pdsm_strategy(simple_machine<2,2>(a_population[p1].genes, a_population[p2].genes)));
             }
             else
-                children.push_back(pdsm_strategy(a_population[p1].genes));
+                a_children.push_back(pdsm_strategy(a_population[p1].genes));
 
             // one down, more to go?
             --a_limit;
         }
 
         // outa here!
-        return children;
+        return true;
     }
 
 private:
@@ -326,12 +328,13 @@ public:
     {
         // get stats for population
         fitness_stats<pdsm_strategy> stats(a_population);
+        show(stats, a_iteration);
+    }
 
-        // display best solution
-        cout << a_iteration << ","
-             << stats.getBest().fitness << ","
-             << stats.getMean() << ","
-             << stats.getSigma() << endl;
+    virtual void ping_generation_end(generation_context<pdsm_strategy> & a_context)
+    {
+        // use the statistics the evocosm shares with its operators
+        show(a_context.get_stats(), a_context.get_iteration());
     }
 
     virtual void run_complete(const vector<pdsm_strategy> & a_population)
@@ -346,6 +349,16 @@ public:
              << "  std. deviation = " << stats.getSigma() << "\n\n"
              << stats.getBest().genes << endl;
     }
+
+private:
+    void show(const fitness_stats<pdsm_strategy> & stats, size_t a_iteration)
+    {
+        // display best solution
+        cout << a_iteration << ","
+             << stats.getBest().fitness << ","
+             << stats.getMean() << ","
+             << stats.getSigma() << endl;
+    }
 };
 
 int main(int argc, char * argv[])
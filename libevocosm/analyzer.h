@@ -56,6 +56,7 @@
 // libevocosm
 #include "organism.h"
 #include "listener.h"
+#include "generation_context.h"
 
 namespace libevocosm
 {
@@ -129,6 +130,19 @@ namespace libevocosm
                 return true;
         }
 
+        //! Reports on a population, with shared statistics
+        /*!
+            The evocosm calls this form, which lets an analyzer use the generation's
+            shared statistics rather than computing its own. By default, it calls
+            the form above.
+            \param a_context - Population, iteration, and statistics for the generation
+            \return <b>true</b> if evolution should continue; <b>false</b> if not
+        */
+        virtual bool analyze(generation_context<OrganismType> & a_context)
+        {
+            return analyze(a_context.get_population(), a_context.get_iteration());
+        }
+
     protected:
         //! The listener for events
         listener<OrganismType> & m_listener;
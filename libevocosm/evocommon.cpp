@@ -94,7 +94,10 @@ libcoyotl::mtwister libevocosm::globals::g_random;
 
 std::string libevocosm::globals::g_version(EVOCOSM_VERSION);
 =======
-libevocosm::prng libevocosm::globals::g_random;
+libevocosm::prng_streams libevocosm::globals::g_random;
+
+// each thread's generator
+thread_local libevocosm::prng_streams::thread_state libevocosm::prng_streams::t_state;
 
 #if defined(_MSC_VER)
 std::string libevocosm::globals::g_version("4.0.0");
@@ -109,57 +109,349 @@ namespace libevocosm
 
 // Standard C++ Library
 #include <string>
+#include <ctime>
+#include <atomic>
+#include <cstdint>
+#include <utility>
 
 namespace libevocosm
 {
     //! The random number generator used by Evocosm
     /*!
         This class encapsulates the random number generator used by the
-        Evocosm classes.
+        Evocosm classes. Seeded with a single 32-bit value, it is Brahe's
+        MWC1038 generator, as it always has been. Seeded as a stream of a
+        master seed, it is a xoshiro256** generator whose entire 256-bit state
+        is derived from the pair, so that no two streams of a seed share any
+        word of their initial state.
     */
     class prng
     {
     private:
         brahe_prng_state_t m_random;
 
+        // is m_random initialized and in use?
+        bool m_brahe;
+
+        // xoshiro256** state, used when m_brahe is false
+        uint64_t m_state[4];
+
     public:
         //! Constructor
         prng()
+          : m_brahe(false)
         {
-            brahe_prng_init(&m_random,BRAHE_PRNG_MWC1038,0);
+            set_seed(0,0);
         }
 
         //! Destructor
         ~prng()
         {
-            brahe_prng_free(&m_random);
+            if (m_brahe)
+                brahe_prng_free(&m_random);
         }
 
         //! Set the seed for the random number generator
         void set_seed(uint32_t a_seed)
         {
+            // release the old state first; streams reseed every generation
+            if (m_brahe)
+                brahe_prng_free(&m_random);
+
             brahe_prng_init(&m_random,BRAHE_PRNG_MWC1038,a_seed);
+            m_brahe = true;
+        }
+
+        //! Set the seed and stream for the random number generator
+        /*!
+            Fills the generator's state from a master seed and a stream number.
+            Each word of the state is a bijective hash of the stream number, keyed
+            by the seed and the word's position, so distinct streams of one seed
+            never start from the same state, however many streams a run uses.
+            \param a_seed - Master seed
+            \param a_stream - Stream number
+        */
+        void set_seed(uint32_t a_seed, uint64_t a_stream)
+        {
+            if (m_brahe)
+            {
+                brahe_prng_free(&m_random);
+                m_brahe = false;
+            }
+
+            uint64_t key = mix(uint64_t(a_seed) + GOLDEN_GAMMA);
+
+            for (int n = 0; n < 4; ++n)
+                m_state[n] = mix(a_stream ^ mix(key + uint64_t(n + 1) * GOLDEN_GAMMA));
+
+            // xoshiro's one forbidden state
+            if ((m_state[0] | m_state[1] | m_state[2] | m_state[3]) == 0)
+                m_state[0] = 1;
         }
 
         //! get seed value
         uint32_t get_seed()
         {
-            return m_random.m_seed;
+            return m_brahe ? m_random.m_seed : 0;
         }
 
         //! get a random index value
         size_t get_index(size_t n)
         {
-            return brahe_prng_index(&m_random,n);
+            if (m_brahe)
+                return brahe_prng_index(&m_random,n);
+
+            return (size_t)(next() % (uint64_t)n);
         }
 
         //! get the next value in the range [0,1)
         double get_real()
         {
-            return brahe_prng_real2(&m_random);
+            if (m_brahe)
+                return brahe_prng_real2(&m_random);
+
+            // the top 53 bits, as a fraction
+            return double(next() >> 11) * (1.0 / 9007199254740992.0);
+        }
+
+        //! Exchange states with another generator
+        /*!
+            \param a_other - Generator whose state is exchanged with this one's
+        */
+        void swap(prng & a_other)
+        {
+            std::swap(m_random, a_other.m_random);
+            std::swap(m_brahe,  a_other.m_brahe);
+
+            for (int n = 0; n < 4; ++n)
+                std::swap(m_state[n], a_other.m_state[n]);
+        }
+
+    private:
+        // a generator owns its Brahe state, so it is not copied
+        prng(const prng &);
+        prng & operator = (const prng &);
+
+        // splitmix64's increment
+        static const uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ULL;
+
+        // splitmix64's finalizer; a bijection on 64-bit values
+        static uint64_t mix(uint64_t z)
+        {
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+
+        static uint64_t rotl(uint64_t x, int k)
+        {
+            return (x << k) | (x >> (64 - k));
+        }
+
+        // the next xoshiro256** value
+        uint64_t next()
+        {
+            uint64_t result = rotl(m_state[1] * 5, 7) * 9;
+            uint64_t t = m_state[1] << 17;
+
+            m_state[2] ^= m_state[0];
+            m_state[3] ^= m_state[1];
+            m_state[1] ^= m_state[2];
+            m_state[0] ^= m_state[3];
+            m_state[2] ^= t;
+            m_state[3] = rotl(m_state[3], 45);
+
+            return result;
         }
     };
 
+    //! Independent random number streams, one per thread
+    /*!
+        Evocosm operators draw random numbers through a prng_streams object, which
+        gives every thread its own generator so that parallel code neither shares
+        state nor waits on a lock. All streams derive from a single master seed:
+        stream zero uses the master seed itself, so a single-threaded run sees the
+        same sequence it always has, and every other stream's generator is seeded
+        in full from the master seed and the stream's 64-bit number.
+        <p>
+        A thread that never calls set_stream is assigned the next unused stream
+        number the first time it draws a value. Code that divides work among
+        threads should bind each piece of work to a fixed stream number, with
+        set_stream or a globals::stream_scope; that makes the results independent
+        of which thread does the work and of the order in which threads start.
+        <p>
+        Setting the seed starts over: the calling thread is bound to stream zero,
+        every other thread is unbound, and stream numbers are handed out from the
+        beginning again, so runs started with the same seed in one process match.
+    */
+    class prng_streams
+    {
+    public:
+        //! A thread's generator and stream, set aside while it plays another
+        struct saved_stream
+        {
+            //! The generator, in the state it was left
+            prng m_prng;
+
+            //! Its stream number
+            uint64_t m_stream;
+
+            //! The seeding it belongs to
+            unsigned long m_epoch;
+        };
+
+        //! Constructor
+        prng_streams()
+          : m_seed(time_seed()),
+            m_epoch(1),
+            m_next_stream(0)
+        {
+            // nada
+        }
+
+        //! Set the master seed
+        /*!
+            Sets the master seed from which all streams derive. The calling thread
+            restarts at the beginning of stream zero; other threads lose their
+            streams, and are assigned new ones, in order from zero, the next time
+            they draw a value. Call this while no other thread is drawing values.
+            \param a_seed - New master seed; zero picks a seed based on the time
+        */
+        void set_seed(uint32_t a_seed)
+        {
+            m_seed = (a_seed != 0) ? a_seed : time_seed();
+            m_next_stream = 0;
+            ++m_epoch;
+
+            // the seeding thread takes stream zero
+            local();
+        }
+
+        //! Get the master seed
+        uint32_t get_seed()
+        {
+            return m_seed;
+        }
+
+        //! Bind the calling thread to a stream
+        /*!
+            Restarts the calling thread's generator at the beginning of a given stream.
+            \param a_stream - Stream number
+        */
+        void set_stream(uint64_t a_stream)
+        {
+            thread_state & state = t_state;
+            state.m_stream = a_stream;
+            state.m_epoch  = m_epoch;
+            reseed(state);
+        }
+
+        //! Get the calling thread's stream number
+        uint64_t get_stream()
+        {
+            local();
+            return t_state.m_stream;
+        }
+
+        //! Set the calling thread's generator aside and bind it to a stream
+        /*!
+            \param a_stream - Stream number
+            \param a_saved - Receives the thread's generator, for leave_stream
+        */
+        void enter_stream(uint64_t a_stream, saved_stream & a_saved)
+        {
+            thread_state & state = t_state;
+            state.m_prng.swap(a_saved.m_prng);
+            a_saved.m_stream = state.m_stream;
+            a_saved.m_epoch  = state.m_epoch;
+            set_stream(a_stream);
+        }
+
+        //! Resume the generator set aside by enter_stream where it left off
+        /*!
+            \param a_saved - The generator saved by enter_stream
+        */
+        void leave_stream(saved_stream & a_saved)
+        {
+            thread_state & state = t_state;
+            state.m_prng.swap(a_saved.m_prng);
+            state.m_stream = a_saved.m_stream;
+            state.m_epoch  = a_saved.m_epoch;
+        }
+
+        //! get a random index value
+        size_t get_index(size_t n)
+        {
+            return local().get_index(n);
+        }
+
+        //! get the next value in the range [0,1)
+        double get_real()
+        {
+            return local().get_real();
+        }
+
+    private:
+        // a seed for runs that don't ask for one
+        static uint32_t time_seed()
+        {
+            uint32_t result = static_cast<uint32_t>(time(NULL));
+            return (result != 0) ? result : 1;
+        }
+
+        // per-thread generator and the stream it is playing
+        struct thread_state
+        {
+            prng          m_prng;
+            uint64_t      m_stream;
+            unsigned long m_epoch;
+
+            thread_state()
+              : m_stream(0), m_epoch(0)
+            {
+                // nada
+            }
+        };
+
+        // seeds a thread's generator for its stream
+        void reseed(thread_state & a_state)
+        {
+            // stream zero is the master seed, as it always has been
+            if (a_state.m_stream == 0)
+                a_state.m_prng.set_seed(m_seed);
+            else
+                a_state.m_prng.set_seed(m_seed, a_state.m_stream);
+        }
+
+        // returns the calling thread's generator, binding it to a stream if it
+        // has none since the master seed was last set
+        prng & local()
+        {
+            thread_state & state = t_state;
+
+            if (state.m_epoch != m_epoch)
+            {
+                state.m_stream = m_next_stream++;
+                state.m_epoch  = m_epoch;
+                reseed(state);
+            }
+
+            return state.m_prng;
+        }
+
+        // master seed
+        std::atomic<uint32_t> m_seed;
+
+        // incremented whenever the master seed changes
+        std::atomic<unsigned long> m_epoch;
+
+        // next stream for threads that don't pick their own
+        std::atomic<uint64_t> m_next_stream;
+
+        // the calling thread's generator
+        static thread_local thread_state t_state;
+    };
+
 >>>>>>> version 4.0.2
     //! Elements shared by all classes in Evocosm
     /*!
@@ -191,8 +483,8 @@ namespace libevocosm
             return g_random.get_index(n);
         }
 
-        //! A shared random number generator
-        static prng g_random;
+        //! A shared random number generator, with an independent stream for each thread
+        static prng_streams g_random;
 
         //! Version number
         static std::string g_version;
@@ -205,6 +497,46 @@ namespace libevocosm
 >>>>>>> version 4.0.2
         }
 
+        //! Bind the calling thread to a random number stream
+        static void set_stream(uint64_t a_stream)
+        {
+            g_random.set_stream(a_stream);
+        }
+
+        //! Binds the calling thread to a random number stream for a scope
+        /*!
+            Sets the calling thread's generator aside and plays a given stream
+            until the object is destroyed; the thread then resumes its previous
+            stream where it left off. Work that draws from a stream of its own
+            holds one, so that its caller's random numbers are unaffected however
+            the work ends.
+        */
+        class stream_scope
+        {
+        public:
+            //! Constructor
+            /*!
+                \param a_stream - Stream to play for the life of the object
+            */
+            explicit stream_scope(uint64_t a_stream)
+            {
+                g_random.enter_stream(a_stream, m_saved);
+            }
+
+            //! Destructor
+            ~stream_scope()
+            {
+                g_random.leave_stream(m_saved);
+            }
+
+        private:
+            stream_scope(const stream_scope &);
+            stream_scope & operator = (const stream_scope &);
+
+            // the generator the thread was playing
+            prng_streams::saved_stream m_saved;
+        };
+
         //! Set the seed for the random number generator
         static uint32_t get_seed()
         {
@@ -101,6 +101,13 @@
 
 // Standard C++ library
 #include <vector>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
 
 <<<<<<< 53bb9b38239f0b6fb908619d97286ae529277d0b
 // libcoyotl
@@ -128,6 +135,11 @@
 =======
 #include "selector.h"
 #include "analyzer.h"
+#include "yielder.h"
+#include "test_hook.h"
+#include "serializer.h"
+#include "generation_context.h"
+#include "genome_pool.h"
 
 
 using std::vector;
@@ -287,6 +299,51 @@ namespace libevocosm
 
         //! Number microseconds for process to sleep on yield
         unsigned int m_sleep_time;
+
+        //! Invoked to let other work run; may be NULL
+        yielder * m_yielder;
+
+        //! Invoked after testing each generation; may be NULL
+        test_hook<OrganismType> * m_test_hook;
+
+        //! Processing time allowed between yields
+        std::chrono::microseconds m_time_slice;
+
+        //! When the current time slice began
+        std::chrono::steady_clock::time_point m_slice_start;
+
+        //! Are generation phases being timed?
+        bool m_timing;
+
+        //! Accumulated time spent in each phase
+        generation_timing m_timing_totals;
+
+        //! Number of threads used for fitness testing
+        size_t m_num_threads;
+
+        //! Number of threads used for breeding and mutation
+        size_t m_breed_threads;
+
+        //! Are scaling and selection done on a separate fitness array?
+        bool m_fitness_apart;
+
+        //! Back buffer in which the next generation is assembled
+        vector<OrganismType> m_next_population;
+
+        //! Children bred by each slice when breeding in parallel
+        vector< vector<OrganismType> > m_breed_buffers;
+
+        //! Indexes of the organisms surviving into the next generation
+        vector<size_t> m_survivors;
+
+        //! Where each survivor landed in the back buffer; used to spot duplicates
+        vector<size_t> m_survivor_slots;
+
+        //! Fitness of the population, by organism, when it is kept apart
+        vector<double> m_fitness;
+
+        //! Identifies this evocosm's random streams among others sharing a seed
+        uint64_t m_stream_id;
 >>>>>>> version 4.0.2
 
     public:
@@ -360,6 +417,14 @@ namespace libevocosm
         evocosm(const evocosm<OrganismType, LandscapeType> & a_source);
 =======
         evocosm(const evocosm<OrganismType> & a_source);
+
+        //! Move constructor
+        /*!
+            Creates a new evocosm that directs the same population and components
+            as an existing one, taking over its back buffers.
+            \param a_source - The source object
+        */
+        evocosm(evocosm<OrganismType> && a_source);
 >>>>>>> version 4.0.2
 
         //! Virtual destructor
@@ -406,6 +471,57 @@ namespace libevocosm
             \return Returns <i>true</i> when the generation has reached a specific goal.
         */
         virtual bool run_generation();
+
+        //! Run generations for a period of time
+        /*!
+            Runs generations until a given amount of time has passed or the analyzer
+            decides evolution is complete, whichever comes first. At least one generation
+            is always run, and a generation in progress is finished before returning.
+            An application with an event loop can call run_for repeatedly, handling
+            events between calls.
+            \param a_duration - How long to run
+            \return <i>true</i> if evolution should continue; <i>false</i> if the run is complete
+        */
+        template <class Rep, class Period>
+        bool run_for(const std::chrono::duration<Rep,Period> & a_duration)
+        {
+            std::chrono::steady_clock::time_point finish = std::chrono::steady_clock::now() + a_duration;
+            bool keep_going;
+
+            m_slice_start = std::chrono::steady_clock::now();
+
+            do
+            {
+                keep_going = run_generation();
+            }
+            while (keep_going && (std::chrono::steady_clock::now() < finish));
+
+            return keep_going;
+        }
+
+        //! Run generations until a condition is met
+        /*!
+            Runs generations until a predicate returns <i>true</i> or the analyzer
+            decides evolution is complete. The predicate is called after each
+            generation as <code>a_done(population, iteration)</code>.
+            \param a_done - Predicate that returns <i>true</i> to stop
+            \return <i>true</i> if evolution should continue; <i>false</i> if the run is complete
+        */
+        template <class Predicate>
+        bool run_until(Predicate a_done)
+        {
+            bool keep_going;
+
+            m_slice_start = std::chrono::steady_clock::now();
+
+            do
+            {
+                keep_going = run_generation();
+            }
+            while (keep_going && !a_done(m_population, m_iteration));
+
+            return keep_going;
+        }
 >>>>>>> version 4.0.2
 
         //! Directly view population
@@ -537,27 +653,362 @@ namespace libevocosm
             m_sleep_time = a_sleep_time;
         }
 
+        //! Get the yielder
+        /*!
+            Gets the object invoked to let other work run.
+            \return The current yielder; NULL if none has been set
+        */
+        yielder * get_yielder()
+        {
+            return m_yielder;
+        }
+
+        //! Set the yielder
+        /*!
+            Sets the object invoked to let other work run. A yielder takes the place of
+            the sleep time; setting it to NULL restores sleeping (if the sleep time is
+            non-zero) or never yielding at all (if it is zero, the default).
+            \param a_yielder - The new yielder, which must exist while the evocosm uses it
+        */
+        void set_yielder(yielder * a_yielder)
+        {
+            m_yielder = a_yielder;
+        }
+
+        //! Get the test hook
+        /*!
+            Gets the object invoked after each generation is tested.
+            \return The current test hook; NULL if none has been set
+        */
+        test_hook<OrganismType> * get_test_hook()
+        {
+            return m_test_hook;
+        }
+
+        //! Set the test hook
+        /*!
+            Sets an object invoked after each generation is tested, while the
+            population still holds raw fitness; see test_hook.
+            \param a_test_hook - The new hook, which must exist while the evocosm uses it; NULL for none
+        */
+        void set_test_hook(test_hook<OrganismType> * a_test_hook)
+        {
+            m_test_hook = a_test_hook;
+        }
+
+        //! Get the time slice
+        /*!
+            Gets the processing time allowed between yields.
+            \return The time slice (microseconds)
+        */
+        unsigned int get_time_slice()
+        {
+            return (unsigned int)m_time_slice.count();
+        }
+
+        //! Set the time slice
+        /*!
+            Sets the processing time allowed between yields. The evocosm checks the
+            clock at the end of each phase of a generation (testing, scaling,
+            selection, breeding, mutation), and yields only if its time slice has been
+            used up. A time slice of zero yields after every phase.
+            \param a_time_slice - The time slice (microseconds)
+        */
+        void set_time_slice(unsigned int a_time_slice)
+        {
+            m_time_slice = std::chrono::microseconds(a_time_slice);
+        }
+
+        //! Get the number of threads
+        /*!
+            Get the number of threads used to test the population.
+            \return Number of threads; zero means the OpenMP default
+        */
+        size_t get_num_threads() const
+        {
+            return m_num_threads;
+        }
+
+        //! Set the number of threads
+        /*!
+            Sets the number of threads used to test the population, passing
+            the value on to the landscape. When more than one thread is used,
+            the landscape's test of a single organism must be thread-safe. By
+            default, an evocosm uses the landscape's setting, which is one.
+            \param a_num_threads - Number of threads; zero selects the OpenMP default, one tests serially
+        */
+        void set_num_threads(size_t a_num_threads)
+        {
+            m_num_threads = a_num_threads;
+            m_landscape.set_num_threads(a_num_threads);
+        }
+
+        //! Get the number of breeding threads
+        /*!
+            Get the number of threads used to breed and mutate children.
+            \return Number of threads; zero means the OpenMP default
+        */
+        size_t get_breed_threads() const
+        {
+            return m_breed_threads;
+        }
+
+        //! Set the number of breeding threads
+        /*!
+            Sets the number of threads used to breed and mutate children. With
+            more than one, the children are divided into that many slices; each
+            slice is bred and mutated by its own thread, drawing on its own random
+            stream, into its own buffer, and the buffers are then appended to the
+            next generation in order. The reproducer's breed and the mutator's
+            mutate are called concurrently, and must be thread-safe; a reproducer
+            that prepares something from the whole population, such as a roulette
+            wheel, does so once per slice. The children depend on the number of
+            slices, but not on the scheduling of threads, and a build without
+            OpenMP breeds the same children serially. Timing reports breeding
+            and mutation together as breeding.
+            \param a_breed_threads - Number of threads; zero selects the OpenMP default, one (the default) breeds serially
+        */
+        void set_breed_threads(size_t a_breed_threads)
+        {
+            m_breed_threads = (a_breed_threads <= MAX_BREED_SLICES) ? a_breed_threads : MAX_BREED_SLICES;
+        }
+
+        //! Are scaling and selection done on a separate fitness array?
+        /*!
+            \return <i>true</i> if fitness is kept apart from the organisms between testing and breeding
+        */
+        bool get_fitness_apart() const
+        {
+            return m_fitness_apart;
+        }
+
+        //! Keep fitness apart from the organisms during scaling and selection
+        /*!
+            When set, each generation copies the tested fitness of its organisms
+            into one contiguous array, as a soa_population keeps it; the scaler
+            and selector then work on that array through their array forms,
+            reading dense doubles rather than striding over organisms. The
+            scaled fitness is copied back to the organisms only after selection,
+            for the reproducer. A scaler or selector that does not implement its
+            array form is used as usual. The array forms compute their own
+            statistics rather than sharing the generation's, so scaled fitness
+            can differ from that of the population path in its last bits, and a
+            run can drift from the one it would otherwise have taken. By
+            default, fitness is not kept apart.
+            \param a_fitness_apart - <i>true</i> to keep fitness in a separate array
+        */
+        void set_fitness_apart(bool a_fitness_apart)
+        {
+            m_fitness_apart = a_fitness_apart;
+        }
+
+        //! Get the fitness cache
+        /*!
+            Gets the landscape's fitness cache.
+            \return The fitness cache; NULL if caching is disabled
+        */
+        fitness_cache<OrganismType> * get_fitness_cache() const
+        {
+            return m_landscape.get_fitness_cache();
+        }
+
+        //! Set the fitness cache
+        /*!
+            Sets the cache the landscape uses to avoid retesting genes it has
+            already seen, such as survivors carried forward by an elitism_selector.
+            Only use a cache with a deterministic landscape that tests organisms
+            individually; see fitness_cache for details.
+            \param a_fitness_cache - The cache, which must exist while the evocosm uses it; NULL disables caching
+        */
+        void set_fitness_cache(fitness_cache<OrganismType> * a_fitness_cache)
+        {
+            m_landscape.set_fitness_cache(a_fitness_cache);
+        }
+
+        //! Is timing enabled?
+        /*!
+            \return <i>true</i> if generation phases are being timed
+        */
+        bool get_timing() const
+        {
+            return m_timing;
+        }
+
+        //! Enable or disable timing
+        /*!
+            When timing is enabled, each phase of run_generation is timed, and the
+            results are sent to the listener's ping_generation_timing at the end of
+            the generation. When it is disabled (the default), the clock is never read.
+            \param a_timing - <i>true</i> to time generation phases
+        */
+        void set_timing(bool a_timing)
+        {
+            m_timing = a_timing;
+        }
+
+        //! Get accumulated timing
+        /*!
+            \return Time spent in each phase of all timed generations
+        */
+        const generation_timing & get_timing_totals() const
+        {
+            return m_timing_totals;
+        }
+
+        //! Reset accumulated timing
+        /*!
+            Sets the accumulated times to zero.
+        */
+        void reset_timing_totals()
+        {
+            m_timing_totals = generation_timing();
+        }
+
+        //! Get the iteration count
+        /*!
+            \return Number of generations run so far
+        */
+        size_t get_iteration() const
+        {
+            return m_iteration;
+        }
+
+        //! Get the stream identifier
+        /*!
+            \return Identifier that selects this evocosm's random streams
+        */
+        uint64_t get_stream_id() const
+        {
+            return m_stream_id;
+        }
+
+        //! Set the stream identifier
+        /*!
+            Each generation draws its random numbers from a stream chosen by the
+            global seed, the stream identifier, and the iteration count, so that
+            a run restored from a checkpoint continues exactly as the original
+            would have. Evocosms that run side by side, such as the islands of an
+            island_model, need different identifiers to evolve differently.
+            \param a_stream_id - The new identifier; defaults to zero
+        */
+        void set_stream_id(uint64_t a_stream_id)
+        {
+            m_stream_id = a_stream_id;
+        }
+
+        //! Save a checkpoint
+        /*!
+            Writes the iteration count, random seed, stream identifier, and
+            population to a binary stream. Fitness values are saved with the
+            organisms. Components such as the landscape and operators are not
+            saved; the evocosm that loads the checkpoint must be constructed
+            with equivalent ones. Checkpoints are only portable between machines
+            with the same byte order.
+            \param a_stream - Destination, opened in binary mode
+        */
+        void save_checkpoint(std::ostream & a_stream) const;
+
+        //! Save a checkpoint to a file
+        /*!
+            Writes a checkpoint to a temporary file, then renames it, so that an
+            interruption never leaves a partial checkpoint in place of the
+            previous one.
+            \param a_filename - Name of the checkpoint file
+        */
+        void save_checkpoint(const std::string & a_filename) const;
+
+        //! Load a checkpoint
+        /*!
+            Restores the iteration count, random seed, stream identifier, and
+            population saved by save_checkpoint. Running generations from a loaded
+            checkpoint reproduces the original run bit for bit, given the same
+            components and a deterministic landscape.
+            \param a_stream - Source, opened in binary mode
+        */
+        void load_checkpoint(std::istream & a_stream);
+
+        //! Load a checkpoint from a file
+        /*!
+            \param a_filename - Name of the checkpoint file
+        */
+        void load_checkpoint(const std::string & a_filename);
+
     protected:
+        //! Breed and mutate children in parallel
+        /*!
+            Appends a_count mutated children to the back buffer, breeding them in
+            slices as described for set_breed_threads.
+            \param a_count - Number of children to breed
+            \param a_slices - Number of slices, at least one and no more than a_count
+        */
+        void breed_slices(size_t a_count, size_t a_slices);
+
+        //! Ends a timed phase
+        /*!
+            If timing is enabled, adds the time since a_mark to a phase, and moves
+            a_mark to the present.
+            \param a_phase - Time for the phase that just ended
+            \param a_mark - When the phase began
+        */
+        void end_phase(double & a_phase, std::chrono::steady_clock::time_point & a_mark)
+        {
+            if (m_timing)
+            {
+                std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+                a_phase += std::chrono::duration<double>(now - a_mark).count();
+                a_mark = now;
+            }
+        }
+
         //! Yield
         /*!
-            Evocosm periodically invokes this function to allow other processes
-            to run. In most cases, this will be some sort of platform-specific
-            sleep function, such as usleep.
+            Evocosm invokes this function between the phases of a generation to allow
+            other work to run. Once the time slice is used up, it calls the yielder
+            or, if there is none, sleeps for the sleep time. With neither, it does
+            nothing, and doesn't even look at the clock.
         */
         void yield()
         {
-            if (m_sleep_time > 0)
+            if ((m_yielder == NULL) && (m_sleep_time == 0))
+                return;
+
+            if (m_time_slice.count() > 0)
             {
-              #if defined(_MSC_VER)
-                Sleep(m_sleep_time);
-              #else
-                usleep((useconds_t)m_sleep_time);
-              #endif
+                if ((std::chrono::steady_clock::now() - m_slice_start) < m_time_slice)
+                    return;
             }
+
+            if (m_yielder != NULL)
+                m_yielder->yield();
+            else
+            {
+                // the same conversion from microseconds as a sleep_yielder
+                sleep_yielder sleeper(m_sleep_time);
+                sleeper.yield();
+            }
+
+            m_slice_start = std::chrono::steady_clock::now();
         }
 
+    private:
+        // generations' random streams start here, clear of those used by threads and islands
+        static const uint64_t GENERATION_STREAM_BASE = uint64_t(1) << 63;
+
+        // breeding slices' streams start here, below the generations' streams
+        static const uint64_t BREED_STREAM_BASE = uint64_t(1) << 62;
+
+        // slices per generation, which fit below the iteration in a breeding stream number
+        static const size_t MAX_BREED_SLICES = size_t(1) << 12;
+
+        // identifies checkpoint files and their format
+        static const char     CHECKPOINT_MAGIC[4];
+        static const uint32_t CHECKPOINT_VERSION = 1;
+        static const uint32_t CHECKPOINT_BYTE_ORDER = 0x01020304;
     };
 
+    template <class OrganismType>
+    const char evocosm<OrganismType>::CHECKPOINT_MAGIC[4] = { 'E', 'V', 'O', 'C' };
+
     // constructors
     template <class OrganismType>
     evocosm<OrganismType>::evocosm(vector<OrganismType> &     a_population,
@@ -577,7 +1028,22 @@ namespace libevocosm
         m_analyzer(a_analyzer),
         m_listener(a_listener),
         m_iteration(0),
-        m_sleep_time(10000) // default to 10ms sleep time
+        m_sleep_time(0), // by default, don't sleep
+        m_yielder(NULL),
+        m_test_hook(NULL),
+        m_time_slice(0),
+        m_slice_start(std::chrono::steady_clock::now()),
+        m_timing(false),
+        m_timing_totals(),
+        m_num_threads(a_landscape.get_num_threads()),
+        m_breed_threads(1),
+        m_fitness_apart(false),
+        m_next_population(),
+        m_breed_buffers(),
+        m_survivors(),
+        m_survivor_slots(),
+        m_fitness(),
+        m_stream_id(0)
     {
         // nada
     }
@@ -585,7 +1051,39 @@ namespace libevocosm
     // copy constructor
     template <class OrganismType>
     evocosm<OrganismType>::evocosm(const evocosm<OrganismType> & a_source)
-      : m_population(a_source.a_population),
+      : m_population(a_source.m_population),
+        m_landscape(a_source.m_landscape),
+        m_mutator(a_source.m_mutator),
+        m_reproducer(a_source.m_reproducer),
+        m_scaler(a_source.m_scaler),
+        m_selector(a_source.m_selector),
+        m_analyzer(a_source.m_analyzer),
+        m_listener(a_source.m_listener),
+        m_iteration(a_source.m_iteration),
+        m_sleep_time(a_source.m_sleep_time),
+        m_yielder(a_source.m_yielder),
+        m_test_hook(a_source.m_test_hook),
+        m_time_slice(a_source.m_time_slice),
+        m_slice_start(std::chrono::steady_clock::now()),
+        m_timing(a_source.m_timing),
+        m_timing_totals(a_source.m_timing_totals),
+        m_num_threads(a_source.m_num_threads),
+        m_breed_threads(a_source.m_breed_threads),
+        m_fitness_apart(a_source.m_fitness_apart),
+        m_next_population(),
+        m_breed_buffers(),
+        m_survivors(),
+        m_survivor_slots(),
+        m_fitness(),
+        m_stream_id(a_source.m_stream_id)
+    {
+        // nada
+    }
+
+    // move constructor
+    template <class OrganismType>
+    evocosm<OrganismType>::evocosm(evocosm<OrganismType> && a_source)
+      : m_population(a_source.m_population),
         m_landscape(a_source.m_landscape),
         m_mutator(a_source.m_mutator),
         m_reproducer(a_source.m_reproducer),
@@ -594,7 +1092,22 @@ namespace libevocosm
         m_analyzer(a_source.m_analyzer),
         m_listener(a_source.m_listener),
         m_iteration(a_source.m_iteration),
-        m_sleep_time(a_source.m_sleep_time)
+        m_sleep_time(a_source.m_sleep_time),
+        m_yielder(a_source.m_yielder),
+        m_test_hook(a_source.m_test_hook),
+        m_time_slice(a_source.m_time_slice),
+        m_slice_start(a_source.m_slice_start),
+        m_timing(a_source.m_timing),
+        m_timing_totals(a_source.m_timing_totals),
+        m_num_threads(a_source.m_num_threads),
+        m_breed_threads(a_source.m_breed_threads),
+        m_fitness_apart(a_source.m_fitness_apart),
+        m_next_population(std::move(a_source.m_next_population)),
+        m_breed_buffers(std::move(a_source.m_breed_buffers)),
+        m_survivors(std::move(a_source.m_survivors)),
+        m_survivor_slots(std::move(a_source.m_survivor_slots)),
+        m_fitness(std::move(a_source.m_fitness)),
+        m_stream_id(a_source.m_stream_id)
 >>>>>>> version 4.0.2
     {
         // nada
@@ -644,11 +1157,154 @@ namespace libevocosm
         m_listener    = a_source.m_analyzer;
         m_iteration   = a_source.m_iteration;
         m_sleep_time  = a_source.m_sleep_time;
+        m_yielder     = a_source.m_yielder;
+        m_test_hook   = a_source.m_test_hook;
+        m_time_slice  = a_source.m_time_slice;
+        m_timing      = a_source.m_timing;
+        m_timing_totals = a_source.m_timing_totals;
+        m_num_threads = a_source.m_num_threads;
+        m_breed_threads = a_source.m_breed_threads;
+        m_fitness_apart = a_source.m_fitness_apart;
+        m_stream_id   = a_source.m_stream_id;
 >>>>>>> version 4.0.2
 
         return *this;
     }
 
+    // breed and mutate children in parallel slices
+    template <class OrganismType>
+    void evocosm<OrganismType>::breed_slices(size_t a_count, size_t a_slices)
+    {
+        if (m_breed_buffers.size() < a_slices)
+            m_breed_buffers.resize(a_slices);
+
+        // each slice's stream is fixed by the generation and the slice, not the thread running it
+        uint64_t first_stream = BREED_STREAM_BASE + (m_stream_id << 40) + (uint64_t(m_iteration) << 12);
+        int slices = (int)a_slices;
+
+        #pragma omp parallel for schedule(static,1) num_threads(slices)
+        for (int s = 0; s < slices; ++s)
+        {
+            vector<OrganismType> & buffer = m_breed_buffers[s];
+            size_t count = a_count / a_slices + (((size_t)s < a_count % a_slices) ? 1 : 0);
+
+            set_stream(first_stream + (uint64_t)s);
+
+            buffer.clear();
+
+            if (!m_reproducer.breed(m_population, count, buffer))
+                buffer = m_reproducer.breed(m_population, count);
+
+            m_mutator.mutate(buffer);
+
+            // blocks left in this thread's genome pool go where the main thread can reuse or trim them
+            genome_pool::flush();
+        }
+
+        // gather the slices in order; the buffers keep their capacity for the next generation
+        for (size_t s = 0; s < a_slices; ++s)
+        {
+            vector<OrganismType> & buffer = m_breed_buffers[s];
+
+            for (size_t n = 0; n < buffer.size(); ++n)
+                m_next_population.push_back(std::move(buffer[n]));
+
+            buffer.clear();
+        }
+    }
+
+    // save a checkpoint
+    template <class OrganismType>
+    void evocosm<OrganismType>::save_checkpoint(std::ostream & a_stream) const
+    {
+        serializer_tools::write_bytes(a_stream, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+        serializer<uint32_t>::write(a_stream, uint32_t(CHECKPOINT_VERSION));
+        serializer<uint32_t>::write(a_stream, uint32_t(CHECKPOINT_BYTE_ORDER));
+
+        serializer<uint32_t>::write(a_stream, get_seed());
+        serializer_tools::write_size(a_stream, m_iteration);
+        serializer<uint64_t>::write(a_stream, m_stream_id);
+        serializer_tools::write_size(a_stream, m_population.size());
+
+        for (size_t n = 0; n < m_population.size(); ++n)
+            organism_serializer<OrganismType>::write(a_stream, m_population[n]);
+    }
+
+    template <class OrganismType>
+    void evocosm<OrganismType>::save_checkpoint(const std::string & a_filename) const
+    {
+        std::string temp_name = a_filename + ".tmp";
+
+        {
+            std::ofstream file(temp_name.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+
+            if (!file)
+                throw std::runtime_error("evocosm: can not create checkpoint " + temp_name);
+
+            save_checkpoint(file);
+            file.flush();
+
+            if (!file)
+                throw std::runtime_error("evocosm: can not write checkpoint " + temp_name);
+        }
+
+        // Windows won't rename over an existing file
+      #if defined(_MSC_VER)
+        std::remove(a_filename.c_str());
+      #endif
+
+        if (std::rename(temp_name.c_str(), a_filename.c_str()) != 0)
+            throw std::runtime_error("evocosm: can not replace checkpoint " + a_filename);
+    }
+
+    // load a checkpoint
+    template <class OrganismType>
+    void evocosm<OrganismType>::load_checkpoint(std::istream & a_stream)
+    {
+        char magic[sizeof(CHECKPOINT_MAGIC)];
+        serializer_tools::read_bytes(a_stream, magic, sizeof(magic));
+
+        for (size_t n = 0; n < sizeof(magic); ++n)
+        {
+            if (magic[n] != CHECKPOINT_MAGIC[n])
+                throw std::runtime_error("evocosm: not a checkpoint");
+        }
+
+        if (serializer<uint32_t>::read(a_stream) != CHECKPOINT_VERSION)
+            throw std::runtime_error("evocosm: unsupported checkpoint version");
+
+        if (serializer<uint32_t>::read(a_stream) != CHECKPOINT_BYTE_ORDER)
+            throw std::runtime_error("evocosm: checkpoint byte order does not match this machine");
+
+        uint32_t seed      = serializer<uint32_t>::read(a_stream);
+        size_t   iteration = serializer_tools::read_size(a_stream);
+        uint64_t stream_id = serializer<uint64_t>::read(a_stream);
+        size_t   count     = serializer_tools::read_size(a_stream);
+
+        // read everything before changing anything, so a bad checkpoint leaves the evocosm intact
+        vector<OrganismType> population;
+        population.reserve(count);
+
+        for (size_t n = 0; n < count; ++n)
+            population.push_back(organism_serializer<OrganismType>::read(a_stream));
+
+        set_seed(seed);
+        m_iteration = iteration;
+        m_stream_id = stream_id;
+        m_population.swap(population);
+    }
+
+    template <class OrganismType>
+    void evocosm<OrganismType>::load_checkpoint(const std::string & a_filename)
+    {
+        std::ifstream file(a_filename.c_str(), std::ios::in | std::ios::binary);
+
+        if (!file)
+            throw std::runtime_error("evocosm: can not open checkpoint " + a_filename);
+
+        load_checkpoint(file);
+    }
+
     // compute next generation
 <<<<<<< 53bb9b38239f0b6fb908619d97286ae529277d0b
     template <class OrganismType, class LandscapeType>
@@ -771,52 +1427,212 @@ namespace libevocosm
 
         OrganismType * best = NULL;
 
+        // phase timing; the clock is only read when timing is enabled
+        generation_timing timing;
+        std::chrono::steady_clock::time_point start;
+        std::chrono::steady_clock::time_point mark;
+
+        if (m_timing)
+        {
+            start = std::chrono::steady_clock::now();
+            mark  = start;
+        }
+
         ++m_iteration;
 
+        // draw this generation's random numbers from a stream determined by the
+        // seed and iteration, so a run resumed from a checkpoint stays on course;
+        // the caller's stream resumes where it left off however the generation ends
+        stream_scope stream(GENERATION_STREAM_BASE + (m_stream_id << 40) + m_iteration);
+
         // announce beginning of new generation
         m_listener.ping_generation_begin(m_population, m_iteration);
+        end_phase(timing.listen, mark);
 
         // check population fitness
         m_landscape.test(m_population);
+
+        if (m_test_hook != NULL)
+            m_test_hook->tested(m_population, m_iteration);
+
+        end_phase(timing.test, mark);
         yield();
+        end_phase(timing.yield, mark);
+
+        // statistics computed on demand, and shared by the listener and operators
+        // until fitness changes
+        generation_context<OrganismType> context(m_population, m_iteration);
 
         // we're done testing this generation
-        m_listener.ping_generation_end(m_population, m_iteration);
+        m_listener.ping_generation_end(context);
+        end_phase(timing.listen, mark);
         yield();
+        end_phase(timing.yield, mark);
 
         // analyze the results of testing, and decide if we're going to stop or not
-        keep_going = m_analyzer.analyze(m_population, m_iteration);
+        keep_going = m_analyzer.analyze(context);
+        end_phase(timing.analyze, mark);
 
         if (keep_going)
         {
-            // fitness scaling
-            m_scaler.scale_fitness(m_population);
-            yield();
+            // fitness scaling, on a dense copy of the tested fitness if it is kept
+            // apart and the scaler can work on one
+            bool scaled_apart = false;
 
-            // get survivors and number of chromosomes to add
-            vector<OrganismType> survivors = m_selector.select_survivors(m_population);
-            yield();
+            if (m_fitness_apart)
+            {
+                m_fitness.resize(m_population.size());
+
+                for (size_t n = 0; n < m_population.size(); ++n)
+                    m_fitness[n] = m_population[n].fitness;
+
+                scaled_apart = m_scaler.scale_fitness(m_fitness);
+            }
 
-            // give birth to new chromosomes
-            vector<OrganismType> children = m_reproducer.breed(m_population, m_population.size() - survivors.size());
+            if (!scaled_apart)
+                m_scaler.scale_fitness(m_population, context);
+
+            context.invalidate();
+            end_phase(timing.scale, mark);
             yield();
+            end_phase(timing.yield, mark);
+
+            // get survivors and number of chromosomes to add; selectors that pick
+            // survivors by index spare us from copying them
+            vector<OrganismType> survivors;
+            bool by_index = false;
+
+            if (scaled_apart)
+            {
+                by_index = m_selector.select_survivors(m_fitness, m_survivors);
 
-            // debugging only
-            //fitness_stats<OrganismType> s(survivors);
-            //fitness_stats<OrganismType> c(children);
+                // the reproducer, and a selector without an array form, read the
+                // scaled fitness from the organisms
+                for (size_t n = 0; n < m_population.size(); ++n)
+                    m_population[n].fitness = m_fitness[n];
+            }
+
+            if (!by_index)
+                by_index = m_selector.select_survivors(m_population, m_survivors, context);
+
+            if (!by_index)
+                survivors = m_selector.select_survivors(m_population);
 
-            // mutate the child chromosomes
-            m_mutator.mutate(children);
+            // a selector that returns more survivors than the population holds
+            // would leave no room for births; keep only as many as fit
+            if (by_index)
+            {
+                if (m_survivors.size() > m_population.size())
+                    m_survivors.resize(m_population.size());
+            }
+            else
+            {
+                if (survivors.size() > m_population.size())
+                    survivors.erase(survivors.begin() + m_population.size(), survivors.end());
+            }
+
+            size_t num_survivors = by_index ? m_survivors.size() : survivors.size();
+            end_phase(timing.select, mark);
             yield();
+            end_phase(timing.yield, mark);
+
+            // give birth to new chromosomes, directly into the back buffer if the
+            // reproducer can; the buffer keeps its capacity from one generation to the next
+            m_next_population.clear();
+            m_next_population.reserve(m_population.size());
 
-            // append children to survivors and replace existing population form combined vector
-            survivors.insert(survivors.end(),children.begin(),children.end());
-            m_population = survivors;
+            size_t num_births = m_population.size() - num_survivors;
+            size_t num_slices = m_breed_threads;
+
+          #if defined(_OPENMP)
+            if (num_slices == 0)
+                num_slices = (size_t)omp_get_max_threads();
+          #else
+            if (num_slices == 0)
+                num_slices = 1;
+          #endif
+
+            if (num_slices > num_births)
+                num_slices = num_births;
+
+            if (num_slices > 1)
+            {
+                // breed and mutate in parallel
+                breed_slices(num_births, num_slices);
+                end_phase(timing.breed, mark);
+                yield();
+                end_phase(timing.yield, mark);
+            }
+            else
+            {
+                if (!m_reproducer.breed(m_population, num_births, m_next_population))
+                {
+                    vector<OrganismType> children = m_reproducer.breed(m_population, num_births);
+
+                    for (size_t n = 0; n < children.size(); ++n)
+                        m_next_population.push_back(std::move(children[n]));
+                }
+
+                end_phase(timing.breed, mark);
+                yield();
+                end_phase(timing.yield, mark);
+
+                // mutate the child chromosomes, which are all the buffer holds so far
+                m_mutator.mutate(m_next_population);
+                end_phase(timing.mutate, mark);
+                yield();
+                end_phase(timing.yield, mark);
+            }
+
+            // add survivors to the back buffer; the parents are no longer needed, so
+            // survivors are moved out of the population, and only duplicates are copied
+            size_t num_children = m_next_population.size();
+
+            if (by_index)
+            {
+                m_survivor_slots.assign(m_population.size(), size_t(-1));
+
+                for (size_t n = 0; n < m_survivors.size(); ++n)
+                {
+                    size_t index = m_survivors[n];
+
+                    if (m_survivor_slots[index] == size_t(-1))
+                    {
+                        m_survivor_slots[index] = m_next_population.size();
+                        m_next_population.push_back(std::move(m_population[index]));
+                    }
+                    else
+                        m_next_population.push_back(m_next_population[m_survivor_slots[index]]);
+                }
+            }
+            else
+            {
+                for (size_t n = 0; n < survivors.size(); ++n)
+                    m_next_population.push_back(std::move(survivors[n]));
+            }
+
+            // survivors come first, as they always have
+            std::rotate(m_next_population.begin(), m_next_population.begin() + num_children, m_next_population.end());
+
+            // swap buffers, then release the old generation
+            m_population.swap(m_next_population);
+            m_next_population.clear();
+            end_phase(timing.replace, mark);
             yield();
+            end_phase(timing.yield, mark);
         }
         else
         {
             m_listener.run_complete(m_population);
+            end_phase(timing.listen, mark);
+        }
+
+        // report timing
+        if (m_timing)
+        {
+            timing.total = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            m_timing_totals += timing;
+            m_listener.ping_generation_timing(timing, m_timing_totals, m_iteration);
         }
 
         return keep_going;
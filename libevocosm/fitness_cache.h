@@ -0,0 +1,318 @@
+/*
+    Evocosm is a C++ framework for implementing evolutionary algorithms.
+
+    Copyright 2011 Scott Robert Ladd. All rights reserved.
+
+    Evocosm is user-supported open source software. Its continued development is dependent
+    on financial support from the community. You can provide funding by visiting the Evocosm
+    website at:
+
+        http://www.coyotegulch.com
+
+    You may license Evocosm in one of two fashions:
+
+    1) Simplified BSD License (FreeBSD License)
+
+    Redistribution and use in source and binary forms, with or without modification, are
+    permitted provided that the following conditions are met:
+
+    1.  Redistributions of source code must retain the above copyright notice, this list of
+        conditions and the following disclaimer.
+
+    2.  Redistributions in binary form must reproduce the above copyright notice, this list
+        of conditions and the following disclaimer in the documentation and/or other materials
+        provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY SCOTT ROBERT LADD ``AS IS'' AND ANY EXPRESS OR IMPLIED
+    WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+    FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SCOTT ROBERT LADD OR
+    CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+    ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+    The views and conclusions contained in the software and documentation are those of the
+    authors and should not be interpreted as representing official policies, either expressed
+    or implied, of Scott Robert Ladd.
+
+    2) Closed-Source Proprietary License
+
+    If your project is a closed-source or proprietary project, the Simplified BSD License may
+    not be appropriate or desirable. In such cases, contact the Evocosm copyright holder to
+    arrange your purchase of an appropriate license.
+
+    The author can be contacted at:
+
+          scott.ladd@coyotegulch.com
+          scott.ladd@gmail.com
+          http:www.coyotegulch.com
+*/
+
+#if !defined(LIBEVOCOSM_FITNESS_CACHE_H)
+#define LIBEVOCOSM_FITNESS_CACHE_H
+
+// Standard C++ Library
+#include <cstddef>
+#include <unordered_map>
+
+// libevocosm
+#include "genome_hash.h"
+
+namespace libevocosm
+{
+    //! What a landscape's test records in an organism
+    /*!
+        A fitness cache stores, for each genome, everything that testing an
+        organism writes into it, and restores all of it on a hit. By default
+        that is the fitness alone. Organisms whose tests record more, such as
+        the value of a function_solution, specialize this template.
+        \param OrganismType - The type of organism tested
+    */
+    template <class OrganismType>
+    struct test_result
+    {
+        //! The recorded results of a test
+        typedef double type;
+
+        //! Copies the results of a test out of an organism
+        static type store(const OrganismType & a_organism)
+        {
+            return a_organism.fitness;
+        }
+
+        //! Gives an organism the results of a test
+        static void restore(OrganismType & a_organism, const type & a_result)
+        {
+            a_organism.fitness = a_result;
+        }
+    };
+
+    //! Remembers the fitness of previously-tested genes
+    /*!
+        When survivors carry forward unchanged, or a reproducer creates a child
+        identical to one already seen, testing it again is wasted effort -- if
+        the landscape is deterministic. A fitness cache maps genome hashes to
+        test results, allowing a landscape to skip those tests.
+
+        A cache is only appropriate when an organism's fitness depends on nothing
+        but its genes. A cached result restores what test_result stores -- the
+        fitness alone, unless the organism type specializes test_result to
+        record more.
+        Landscapes that score organisms against each other, such as tournaments,
+        must not use a cache.
+
+        This class defines the interface a landscape uses; a genome_fitness_cache
+        supplies the hash function.
+        \param OrganismType - The type of organism whose fitness is cached
+    */
+    template <class OrganismType>
+    class fitness_cache
+    {
+    public:
+        //! The recorded results of a test
+        typedef typename test_result<OrganismType>::type result_t;
+
+        //! Constructor
+        /*!
+            Creates a new, empty cache.
+            \param a_capacity - Maximum number of entries; zero for no limit
+        */
+        fitness_cache(size_t a_capacity = 100000)
+          : m_table(),
+            m_capacity(a_capacity),
+            m_hits(0),
+            m_misses(0)
+        {
+            // nada
+        }
+
+        //! Virtual destructor
+        /*!
+            A virtual destructor. By default, it does nothing; this is
+            a placeholder that identifies this class as a potential base,
+            ensuring that objects of a derived class will have their
+            destructors called if they are destroyed through a base-class
+            pointer.
+        */
+        virtual ~fitness_cache()
+        {
+            // nada
+        }
+
+        //! Computes the key for an organism
+        /*!
+            Hashes the genes of an organism; organisms with equal genes must
+            have equal keys.
+            \param a_organism - The organism to be hashed
+            \return Key for a_organism
+        */
+        virtual uint64_t hash(const OrganismType & a_organism) const = 0;
+
+        //! Finds a test result
+        /*!
+            Looks for a key in the cache. Lookups are not counted as hits or
+            misses; the caller reports them via count_lookups.
+            \param a_key - The key to look for
+            \param a_result - Receives the cached result, if the key is found
+            \return <i>true</i> if the key was found
+        */
+        bool lookup(uint64_t a_key, result_t & a_result) const
+        {
+            typename std::unordered_map<uint64_t,result_t>::const_iterator entry = m_table.find(a_key);
+
+            if (entry == m_table.end())
+                return false;
+
+            a_result = entry->second;
+            return true;
+        }
+
+        //! Stores a test result
+        /*!
+            Stores the result associated with a key. When the cache is full, it
+            is emptied before the new result is stored; entries from recent
+            generations are the ones most likely to be useful.
+            \param a_key - The key
+            \param a_result - Result associated with a_key
+        */
+        void insert(uint64_t a_key, const result_t & a_result)
+        {
+            if ((m_capacity > 0) && (m_table.size() >= m_capacity))
+                m_table.clear();
+
+            m_table[a_key] = a_result;
+        }
+
+        //! Counts lookups
+        /*!
+            Adds to the hit and miss counters.
+            \param a_hits - Number of tests avoided
+            \param a_misses - Number of tests performed
+        */
+        void count_lookups(size_t a_hits, size_t a_misses)
+        {
+            m_hits   += a_hits;
+            m_misses += a_misses;
+        }
+
+        //! Empties the cache
+        /*!
+            Removes all entries; the hit and miss counters are unchanged.
+        */
+        void clear()
+        {
+            m_table.clear();
+        }
+
+        //! Resets the counters
+        /*!
+            Sets the hit and miss counters to zero.
+        */
+        void reset_counters()
+        {
+            m_hits   = 0;
+            m_misses = 0;
+        }
+
+        //! Get the number of hits
+        /*!
+            \return The number of tests avoided by the cache
+        */
+        size_t get_hits() const
+        {
+            return m_hits;
+        }
+
+        //! Get the number of misses
+        /*!
+            \return The number of tests performed because genes were not in the cache
+        */
+        size_t get_misses() const
+        {
+            return m_misses;
+        }
+
+        //! Get the number of entries
+        /*!
+            \return The number of results currently stored
+        */
+        size_t get_size() const
+        {
+            return m_table.size();
+        }
+
+        //! Get the capacity
+        /*!
+            \return Maximum number of entries; zero means no limit
+        */
+        size_t get_capacity() const
+        {
+            return m_capacity;
+        }
+
+        //! Set the capacity
+        /*!
+            \param a_capacity - Maximum number of entries; zero for no limit
+        */
+        void set_capacity(size_t a_capacity)
+        {
+            m_capacity = a_capacity;
+        }
+
+    protected:
+        //! Test results, by key
+        std::unordered_map<uint64_t,result_t> m_table;
+
+        //! Maximum number of entries
+        size_t m_capacity;
+
+        //! Number of tests avoided
+        size_t m_hits;
+
+        //! Number of tests performed
+        size_t m_misses;
+    };
+
+    //! A fitness cache keyed by a genome hash
+    /*!
+        Hashes organisms with a genome_hash specialization for their genotype.
+        \param OrganismType - The type of organism whose fitness is cached
+        \param Hash - Function object hashing OrganismType::genotype_t
+    */
+    template <class OrganismType, class Hash = genome_hash<typename OrganismType::genotype_t> >
+    class genome_fitness_cache : public fitness_cache<OrganismType>
+    {
+    public:
+        //! Constructor
+        /*!
+            Creates a new, empty cache.
+            \param a_capacity - Maximum number of entries; zero for no limit
+            \param a_hash - The hash function
+        */
+        genome_fitness_cache(size_t a_capacity = 100000, const Hash & a_hash = Hash())
+          : fitness_cache<OrganismType>(a_capacity),
+            m_hash(a_hash)
+        {
+            // nada
+        }
+
+        //! Computes the key for an organism
+        /*!
+            Hashes the genes of an organism.
+            \param a_organism - The organism to be hashed
+            \return Key for a_organism
+        */
+        virtual uint64_t hash(const OrganismType & a_organism) const
+        {
+            return m_hash(a_organism.genes);
+        }
+
+    private:
+        // the hash function
+        Hash m_hash;
+    };
+};
+
+#endif
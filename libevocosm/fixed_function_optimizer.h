@@ -0,0 +1,630 @@
+/*
+    Evocosm is a C++ framework for implementing evolutionary algorithms.
+
+    Copyright 2011 Scott Robert Ladd. All rights reserved.
+
+    Evocosm is user-supported open source software. Its continued development is dependent
+    on financial support from the community. You can provide funding by visiting the Evocosm
+    website at:
+
+        http://www.coyotegulch.com
+
+    You may license Evocosm in one of two fashions:
+
+    1) Simplified BSD License (FreeBSD License)
+
+    Redistribution and use in source and binary forms, with or without modification, are
+    permitted provided that the following conditions are met:
+
+    1.  Redistributions of source code must retain the above copyright notice, this list of
+        conditions and the following disclaimer.
+
+    2.  Redistributions in binary form must reproduce the above copyright notice, this list
+        of conditions and the following disclaimer in the documentation and/or other materials
+        provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY SCOTT ROBERT LADD ``AS IS'' AND ANY EXPRESS OR IMPLIED
+    WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+    FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SCOTT ROBERT LADD OR
+    CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+    ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+    The views and conclusions contained in the software and documentation are those of the
+    authors and should not be interpreted as representing official policies, either expressed
+    or implied, of Scott Robert Ladd.
+
+    2) Closed-Source Proprietary License
+
+    If your project is a closed-source or proprietary project, the Simplified BSD License may
+    not be appropriate or desirable. In such cases, contact the Evocosm copyright holder to
+    arrange your purchase of an appropriate license.
+
+    The author can be contacted at:
+
+          scott.ladd@coyotegulch.com
+          scott.ladd@gmail.com
+          http:www.coyotegulch.com
+*/
+
+#if !defined(EVOCOSM_FIXED_FUNCTION_OPTIMIZER_H)
+#define EVOCOSM_FIXED_FUNCTION_OPTIMIZER_H
+
+// Standard C++ Library
+#include <array>
+#include <vector>
+#include <utility>
+#include <iostream>
+#include <iomanip>
+
+// other elements of Evocosm
+#include "roulette.h"
+#include "function_optimizer.h"
+
+namespace libevocosm
+{
+    //! Global things used by all fixed-dimension optimizer classes
+    /*!
+        The fixed-dimension optimizer mirrors function_optimizer, but its
+        solutions store their arguments inline, in an array whose size is a
+        template parameter. Testing, mutating, and breeding a solution then
+        never touches the heap, and the compiler can unroll the loops over
+        its arguments.
+        \param N - Number of arguments to the function
+    */
+    template <size_t N>
+    class fixed_fopt_global : protected fopt_global
+    {
+    protected:
+        //! The arguments to a function
+        typedef std::array<double,N> t_args;
+
+        //! Definition of a function type
+        /*!
+            As for function_optimizer, the function may be anything. It returns the
+            value of the function and the fitness of the arguments, in that order;
+            neither the arguments nor the result are copied to the heap.
+        */
+        typedef std::array<double,2> t_function(const t_args & a_args);
+    };
+
+    //! A potential solution with a fixed number of arguments
+    /*!
+        Like function_solution, but the genes are an array of N doubles stored
+        in the solution itself. The solution has no virtual functions, so a
+        population of them is one contiguous block that is copied in bulk.
+        \param N - Number of arguments to the function
+    */
+    template <size_t N>
+    class fixed_function_solution : public compact_organism< std::array<double,N> >, protected globals
+    {
+    public:
+        /*!
+            Value is the actual computed value of this solution, as for
+            function_solution.
+        */
+        double value;
+
+        //! Default contructor
+        /*!
+            Creates a solution with every argument zero.
+        */
+        fixed_function_solution()
+          : compact_organism< std::array<double,N> >(),
+            value(0.0)
+        {
+            this->genes.fill(0.0);
+        }
+
+        //! Creation constructor
+        /*!
+            Creates a new solution with random arguments.
+            \param a_minarg - minimum argument value
+            \param a_maxarg - maximum argument value
+        */
+        fixed_function_solution(double a_minarg, double a_maxarg)
+          : compact_organism< std::array<double,N> >(),
+            value(0.0)
+        {
+            if (a_maxarg < a_minarg)
+            {
+                double temp = a_maxarg;
+                a_maxarg = a_minarg;
+                a_minarg = temp;
+            }
+
+            double extent = a_maxarg - a_minarg;
+
+            for (size_t n = 0; n < N; ++n)
+                this->genes[n] = g_random.get_real() * extent + a_minarg;
+        }
+
+        //! Construct from raw genes
+        /*!
+            Constructs a new function solution from a set of genes
+            \param a_source - The arguments
+        */
+        fixed_function_solution(const std::array<double,N> & a_source)
+          : compact_organism< std::array<double,N> >(a_source),
+            value(0.0)
+        {
+            // nada
+        }
+    };
+
+    //! What testing a fixed_function_solution records
+    /*!
+        As for function_solution, a fitness cache stores and restores the value
+        along with the fitness.
+        \param N - Number of arguments to the function
+    */
+    template <size_t N>
+    struct test_result< fixed_function_solution<N> >
+    {
+        //! The value and the fitness, in that order
+        typedef std::pair<double,double> type;
+
+        //! Copies the results of a test out of a solution
+        static type store(const fixed_function_solution<N> & a_organism)
+        {
+            return type(a_organism.value, a_organism.fitness);
+        }
+
+        //! Gives a solution the results of a test
+        static void restore(fixed_function_solution<N> & a_organism, const type & a_result)
+        {
+            a_organism.value   = a_result.first;
+            a_organism.fitness = a_result.second;
+        }
+    };
+
+    //! Hashes the arguments of a fixed_function_solution
+    /*!
+        Lets a genome_fitness_cache key fixed-dimension solutions.
+        \param N - Number of arguments to the function
+    */
+    template <size_t N>
+    struct genome_hash< std::array<double,N> >
+    {
+        //! Computes the hash
+        /*!
+            \param a_genes - Genes to be hashed
+            \return 64-bit hash of a_genes
+        */
+        uint64_t operator () (const std::array<double,N> & a_genes) const
+        {
+            uint64_t result = genome_hash_tools::mix(genome_hash_tools::HASH_SEED, (uint64_t)N);
+
+            for (size_t n = 0; n < N; ++n)
+                result = genome_hash_tools::mix(result, a_genes[n]);
+
+            return result;
+        }
+    };
+
+    //! Mutates fixed-dimension solutions
+    /*!
+        Implements chance-based mutation of solutions, as function_mutator does.
+        \param N - Number of arguments to the function
+    */
+    template <size_t N>
+    class fixed_function_mutator : public mutator< fixed_function_solution<N> >, protected fixed_fopt_global<N>
+    {
+    public:
+        //! Creation constructor
+        /*!
+            Creates a new mutator with a given mutation rate.
+            \param a_mutation_rate - Chance that an argument mutates, in the range [0,1]
+        */
+        fixed_function_mutator(double a_mutation_rate)
+          : m_mutation_rate(a_mutation_rate)
+        {
+            // adjust mutation rate if necessary
+            if (m_mutation_rate > 1.0)
+                m_mutation_rate = 1.0;
+            else if (m_mutation_rate < 0.0)
+                m_mutation_rate = 0.0;
+        }
+
+        //! Gets the mutation rate
+        /*!
+            Returns the mutation rate set for this mutator.
+            \return Mutation rate
+        */
+        double mutation_rate() const
+        {
+            return m_mutation_rate;
+        }
+
+        //! Performs mutations
+        /*!
+            Mutates a solution using the facilities provided by g_evoreal.
+            \param a_population - Solutions to be mutated
+        */
+        void mutate(vector< fixed_function_solution<N> > & a_population)
+        {
+            for (size_t i = 0; i < a_population.size(); ++i)
+            {
+                std::array<double,N> & genes = a_population[i].genes;
+
+                for (size_t n = 0; n < N; ++n)
+                {
+                    if (globals::g_random.get_real() <= m_mutation_rate)
+                        genes[n] = fopt_global::g_evoreal.mutate(genes[n]);
+                }
+            }
+        }
+
+    private:
+        // rate of mutation
+        double m_mutation_rate;
+    };
+
+    //! Implements reproduction for fixed-dimension solutions
+    /*!
+        Breeds solutions as function_reproducer does, choosing first parents
+        from a fitness wheel in one sweep and crossing arguments pairwise.
+        \param N - Number of arguments to the function
+    */
+    template <size_t N>
+    class fixed_function_reproducer : public reproducer< fixed_function_solution<N> >, protected fixed_fopt_global<N>
+    {
+    public:
+        //! Creation constructor
+        /*!
+            Creates a new reproducer with a given crossover rate.
+            \param a_crossover_rate - Chance that a child has two parents, in the range [0,1]
+        */
+        fixed_function_reproducer(double a_crossover_rate = 1.0)
+            : m_crossover_rate(a_crossover_rate)
+        {
+            // adjust crossover rate if necessary
+            if (m_crossover_rate > 1.0)
+                m_crossover_rate = 1.0;
+            else if (m_crossover_rate < 0.0)
+                m_crossover_rate = 0.0;
+        }
+
+        //! Gets the crossover rate
+        /*!
+            Returns the crossover rate set for this reproducer.
+            \return Crossover rate
+        */
+        double crossover_rate() const
+        {
+            return m_crossover_rate;
+        }
+
+        //! Reproduction for solutions
+        /*!
+            Breeds new solutions, by cloning or by crossover between two parents.
+            \param a_population - A population of solutions
+            \param a_limit - Maximum number of children
+            \param a_children - Vector to which children are appended
+            \return <i>true</i>
+        */
+        virtual bool breed(const vector< fixed_function_solution<N> > & a_population, size_t a_limit, vector< fixed_function_solution<N> > & a_children)
+        {
+            // construct a fitness wheel
+            vector<double> wheel_weights(a_population.size());
+
+            for (size_t i = 0; i < a_population.size(); ++i)
+                wheel_weights[i] = (a_population[i].fitness > 0.0) ? a_population[i].fitness : 0.0;
+
+            alias_roulette_wheel fitness_wheel(wheel_weights);
+
+            // select every child's first parent in one sweep
+            vector<size_t> parents;
+            fitness_wheel.sample(a_limit, parents, true);
+
+            // create children
+            a_children.reserve(a_children.size() + a_limit);
+
+            for (size_t c = 0; c < parents.size(); ++c)
+            {
+                // clone an existing organism as a child
+                size_t g1 = parents[c];
+                std::array<double,N> child = a_population[g1].genes;
+
+                // do we crossover?
+                if (globals::g_random.get_real() < m_crossover_rate)
+                {
+                    // select a second parent
+                    size_t g2 = g1;
+
+                    while (g2 == g1)
+                        g2 = fitness_wheel.get_index();
+
+                    const std::array<double,N> & parent2 = a_population[g2].genes;
+
+                    // reproduce
+                    for (size_t n = 0; n < N; ++n)
+                        child[n] = fopt_global::g_evoreal.crossover(child[n],parent2[n]);
+                }
+
+                // add child to new population
+                a_children.push_back(fixed_function_solution<N>(child));
+            }
+
+            return true;
+        }
+
+        // the vector-returning form is the base class adapter
+        using reproducer< fixed_function_solution<N> >::breed;
+
+    private:
+        // crossover chance
+        double m_crossover_rate;
+    };
+
+    //! Defines the test for a population of fixed-dimension solutions
+    /*!
+        Calls the function being optimized with a reference to each solution's
+        arguments.
+        \param N - Number of arguments to the function
+    */
+    template <size_t N>
+    class fixed_function_landscape : public landscape< fixed_function_solution<N> >, protected fixed_fopt_global<N>
+    {
+    public:
+        //! The function type tested by this landscape
+        typedef typename fixed_fopt_global<N>::t_function t_function;
+
+        //! Creation constructor
+        /*!
+            Creates a new landscape with a given fitness function.
+            \param a_function function to be tested
+            \param a_listener a listener for events during testing
+        */
+        fixed_function_landscape(t_function * a_function, listener< fixed_function_solution<N> > & a_listener)
+          : landscape< fixed_function_solution<N> >(a_listener),
+            m_function(a_function)
+        {
+            // nada
+        }
+
+        //! Performs fitness testing
+        /*!
+            Tests a single solution by calling the function provided in the constructor.
+            \param a_organism the organism to be tested by the landscape.
+            \param a_verbose should this test produce lots of output?
+            \return Computed fitness for this organism
+        */
+        virtual double test(fixed_function_solution<N> & a_organism, bool a_verbose = false) const
+        {
+            std::array<double,2> z = m_function(a_organism.genes);
+            a_organism.value   = z[0];
+            a_organism.fitness = z[1];
+            return a_organism.fitness;
+        }
+
+        // the population form is inherited
+        using landscape< fixed_function_solution<N> >::test;
+
+    private:
+        // fitness function pointer
+        t_function * m_function;
+    };
+
+    //! Reports the state of a population of fixed-dimension solutions
+    /*!
+        Stops evolution when the best solution is unchanged for twenty
+        generations, or after a maximum number of iterations, as
+        function_analyzer does.
+        \param N - Number of arguments to the function
+    */
+    template <size_t N>
+    class fixed_function_analyzer : public analyzer< fixed_function_solution<N> >
+    {
+    public:
+        //! Constructor
+        /*!
+            Creates a new analyzer object
+            \param a_listener - a listener for events
+            \param a_max_iterations - Maximum number of iterations
+        */
+        fixed_function_analyzer(listener< fixed_function_solution<N> > & a_listener, size_t a_max_iterations)
+            : analyzer< fixed_function_solution<N> >(a_listener, a_max_iterations),
+              m_prev_best(),
+              m_count(0)
+        {
+            // nada
+        }
+
+        //! Reports on a population
+        /*!
+            \param a_population - A population of organisms
+            \param a_iteration - Iteration count for this report
+            \return <b>true</b> if evolution should continue; <b>false</b> if not
+        */
+        virtual bool analyze(const vector< fixed_function_solution<N> > & a_population, size_t a_iteration)
+        {
+            fitness_stats< fixed_function_solution<N> > stats(a_population);
+            return check(stats.getBest(), a_iteration);
+        }
+
+        //! Reports on a population, with shared statistics
+        /*!
+            \param a_context - Population, iteration, and statistics for the generation
+            \return <b>true</b> if evolution should continue; <b>false</b> if not
+        */
+        virtual bool analyze(generation_context< fixed_function_solution<N> > & a_context)
+        {
+            return check(a_context.get_stats().getBest(), a_context.get_iteration());
+        }
+
+    private:
+        // counts generations with the same best solution
+        bool check(const fixed_function_solution<N> & a_best, size_t a_iteration)
+        {
+            if (m_prev_best == a_best.genes)
+                ++m_count;
+            else
+                m_count = 0;
+
+            m_prev_best = a_best.genes;
+
+            // if the best is the same twenty generations in a row, we're done (in theory)
+            return ((m_count < 20) && ((this->m_max_iterations == 0) || (a_iteration < this->m_max_iterations)));
+        }
+
+        std::array<double,N> m_prev_best;
+        size_t m_count;
+    };
+
+    //! Displays the best solution of each generation
+    /*!
+        Writes the best solution of every generation to stdout, as
+        function_listener does.
+        \param N - Number of arguments to the function
+    */
+    template <size_t N>
+    class fixed_function_listener : public null_listener< fixed_function_solution<N> >
+    {
+    public:
+        //! Ping that a generation ends
+        /*!
+            \param a_population population for which processing has ended
+            \param a_iteration One-based number of the generation ended
+        */
+        virtual void ping_generation_end(const vector< fixed_function_solution<N> > & a_population, size_t a_iteration)
+        {
+            fitness_stats< fixed_function_solution<N> > stats(a_population);
+            show_best(stats.getBest(), a_iteration);
+        }
+
+        //! Ping that a generation ends, with shared statistics
+        /*!
+            \param a_context Population, iteration, and statistics for the generation
+        */
+        virtual void ping_generation_end(generation_context< fixed_function_solution<N> > & a_context)
+        {
+            show_best(a_context.get_stats().getBest(), a_context.get_iteration());
+        }
+
+    private:
+        // displays the best solution of a generation
+        void show_best(const fixed_function_solution<N> & a_best, size_t a_iteration)
+        {
+            // save format state of cout
+            std::ios_base::fmtflags save_state = std::cout.flags();
+
+            // display best solution
+            std::cout << std::setw(5) << std::setfill(' ') << a_iteration << ": (";
+
+            std::cout << std::showpoint << std::setprecision(8) << std::showpos;
+
+            for (size_t n = 0; n < N; ++n)
+                std::cout << std::right << std::setw(11) << a_best.genes[n] << ", " ;
+
+            std::cout << std::noshowpos << "\b\b) = " <<  a_best.value << " [fit = " << a_best.fitness << "]" << std::endl;
+
+            // restore format state of cout
+            std::cout.flags(save_state);
+        }
+    };
+
+    //! A function optimizer for a fixed number of arguments
+    /*!
+        Binds together the fixed-dimension classes as function_optimizer binds
+        together its own. The function receives a reference to the arguments
+        and returns its value and fitness in an array, so evolution allocates
+        nothing per solution.
+        \param N - Number of arguments to the function
+    */
+    template <size_t N>
+    class fixed_function_optimizer : protected fixed_fopt_global<N>, protected fixed_function_listener<N>
+    {
+    public:
+        //! The function type optimized
+        typedef typename fixed_fopt_global<N>::t_function t_function;
+
+        //! Constructor
+        /*!
+            Creates a new fixed_function_optimizer with the given set of parameters.
+            \param a_function - Address of the function to be optimized.
+            \param a_minarg - minimum argument value
+            \param a_maxarg - maximum argument value
+            \param a_norgs - The size of the solution population.
+            \param a_mutation_rate - Mutation rate in the range [0,1].
+            \param a_iterations - Number of iterations to perform when doing a run.
+        */
+        fixed_function_optimizer(t_function * a_function,
+                                 double       a_minarg,
+                                 double       a_maxarg,
+                                 size_t       a_norgs,
+                                 double       a_mutation_rate,
+                                 size_t       a_iterations)
+          : m_population(),
+            m_landscape(a_function, *this),
+            m_mutator(a_mutation_rate),
+            m_reproducer(0.9),      // use crossover 90% of the time during reproduction
+            m_scaler(10.0),         // scale fitness(0..10)
+            m_selector(0.90),       // keep those with fitness >= .9 best
+            m_analyzer(*this, a_iterations),
+            m_evocosm(NULL)
+        {
+            // create the population
+            m_population.reserve(a_norgs);
+
+            for (size_t n = 0; n < a_norgs; ++n)
+                m_population.push_back(fixed_function_solution<N>(a_minarg,a_maxarg));
+
+            // create an evocosm to evolve the population
+            m_evocosm = new evocosm< fixed_function_solution<N> >(m_population,
+                                                                  m_landscape,
+                                                                  m_mutator,
+                                                                  m_reproducer,
+                                                                  m_scaler,
+                                                                  m_selector,
+                                                                  m_analyzer,
+                                                                  *this);
+        }
+
+        //! Destructor
+        /*!
+            Cleans up resources by removing allocated objects.
+        */
+        virtual ~fixed_function_optimizer()
+        {
+            delete m_evocosm;
+        }
+
+        //! Performs optimization
+        /*!
+            Runs generations until the analyzer stops evolution, reporting the best
+            solution of each.
+        */
+        void run()
+        {
+            m_evocosm->set_sleep_time(0);
+
+            // continue for specified number of iterations
+            while (m_evocosm->run_generation()) { /* nada */ }
+
+            std::cout << "run complete" << std::endl;
+        }
+
+    private:
+        // not copyable; the evocosm refers to members
+        fixed_function_optimizer(const fixed_function_optimizer & a_source);
+        fixed_function_optimizer & operator = (const fixed_function_optimizer & a_source);
+
+        // objects that define the characteristics of the genetic algorithm
+        vector< fixed_function_solution<N> >             m_population;
+        fixed_function_landscape<N>                      m_landscape;
+        fixed_function_mutator<N>                        m_mutator;
+        fixed_function_reproducer<N>                     m_reproducer;
+        linear_norm_scaler< fixed_function_solution<N> > m_scaler;
+        elitism_selector< fixed_function_solution<N> >   m_selector;
+        fixed_function_analyzer<N>                       m_analyzer;
+
+        // the evocosm binds it all together
+        evocosm< fixed_function_solution<N> > * m_evocosm;
+    };
+};
+
+#endif
@@ -76,7 +76,7 @@ void function_mutator::mutate(vector<function_solution> & a_population)
 }
 
 // create children
-vector<function_solution> function_reproducer::breed(const vector<function_solution> & a_population, size_t a_limit)
+bool function_reproducer::breed(const vector<function_solution> & a_population, size_t a_limit, vector<function_solution> & a_children)
 {
     // construct a fitness wheel
     vector<double> wheel_weights;
@@ -84,15 +84,19 @@ vector<function_solution> function_reproducer::breed(const vector<function_solut
     for (int i = 0; i < a_population.size(); ++i)
         wheel_weights.push_back(a_population[i].fitness > 0.0 ? a_population[i].fitness : 0.0);
 
-    roulette_wheel fitness_wheel(wheel_weights);
+    alias_roulette_wheel fitness_wheel(wheel_weights);
+
+    // select every child's first parent in one sweep
+    vector<size_t> parents;
+    fitness_wheel.sample(a_limit, parents, true);
 
     // create children
-    vector<function_solution> children;
+    a_children.reserve(a_children.size() + a_limit);
 
-    while (a_limit > 0)
+    for (size_t c = 0; c < parents.size(); ++c)
     {
         // clone an existing organism as a child
-        size_t g1 = fitness_wheel.get_index();
+        size_t g1 = parents[c];
         vector<double> parent1 = a_population[g1].genes;
 
         // do we crossover?
@@ -104,7 +108,7 @@ vector<function_solution> function_reproducer::breed(const vector<function_solut
             while (g2 == g1)
                 g2 = fitness_wheel.get_index();
 
-            const vector<double> parent2 = a_population[g2].genes;
+            const vector<double> & parent2 = a_population[g2].genes;
 
             // reproduce
             for (size_t n = 0; n < parent1.size(); ++n)
@@ -112,14 +116,36 @@ vector<function_solution> function_reproducer::breed(const vector<function_solut
         }
 
         // add child to new population
-        children.push_back(function_solution(parent1));
-
-        // one down, more to go?
-        --a_limit;
+        a_children.push_back(function_solution(std::move(parent1)));
     }
 
     // outa here!
-    return children;
+    return true;
+}
+
+// create a child from parents chosen by tournament
+function_solution function_tournament_reproducer::mate(const vector<function_solution> & a_population, size_t a_parent)
+{
+    // clone an existing organism as a child
+    vector<double> child = a_population[a_parent].genes;
+
+    // do we crossover?
+    if (g_random.get_real() < m_crossover_rate)
+    {
+        // select a second parent, different from the first if possible
+        size_t g2 = select_parent(a_population);
+
+        for (int tries = 0; (g2 == a_parent) && (tries < 8); ++tries)
+            g2 = select_parent(a_population);
+
+        const vector<double> & parent2 = a_population[g2].genes;
+
+        // reproduce
+        for (size_t n = 0; n < child.size(); ++n)
+            child[n] = g_evoreal.crossover(child[n],parent2[n]);
+    }
+
+    return function_solution(std::move(child));
 }
 
 // say something about a population
@@ -128,15 +154,39 @@ bool function_analyzer::analyze(const vector<function_solution> & a_population,
                                 double & a_fitness)
 {
     fitness_stats<function_solution> stats(a_population);
+    track(stats.getBest());
 
+    // if the best is the same ten generations in a row, we're done (in theory)
+    return ((m_count < 20) || (m_max_iterations == a_iteration));
+}
+
+bool function_analyzer::analyze(const vector<function_solution> & a_population, size_t a_iteration)
+{
+    fitness_stats<function_solution> stats(a_population);
+    track(stats.getBest());
+
+    // if the best is the same twenty generations in a row, we're done (in theory)
+    return ((m_count < 20) && ((m_max_iterations == 0) || (a_iteration < m_max_iterations)));
+}
+
+bool function_analyzer::analyze(generation_context<function_solution> & a_context)
+{
+    track(a_context.get_stats().getBest());
+
+    // if the best is the same twenty generations in a row, we're done (in theory)
+    return ((m_count < 20) && ((m_max_iterations == 0) || (a_context.get_iteration() < m_max_iterations)));
+}
+
+void function_analyzer::track(const function_solution & a_best)
+{
     // see if the current best equals the previous best
-    if (m_prev_best.genes.size() == stats.getBest().genes.size())
+    if (m_prev_best.genes.size() == a_best.genes.size())
     {
         bool equal = true;
 
         for (int n = 0; n < m_prev_best.genes.size(); ++n)
         {
-            if (m_prev_best.genes[n] != stats.getBest().genes[n])
+            if (m_prev_best.genes[n] != a_best.genes[n])
             {
                 equal = false;
                 break;
@@ -149,10 +199,7 @@ bool function_analyzer::analyze(const vector<function_solution> & a_population,
             m_count = 0;
     }
 
-    m_prev_best = stats.getBest();
-
-    // if the best is the same ten generations in a row, we're done (in theory)
-    return ((m_count < 20) || (m_max_iterations == a_iteration));
+    m_prev_best = a_best;
 }
 
 void function_listener::ping_generation_begin(size_t a_iteration)
@@ -165,6 +212,16 @@ void function_listener::ping_generation_end(const vector<function_solution> & a_
     // get stats for population
     fitness_stats<function_solution> stats(a_population);
 
+    show_best(stats.getBest(), a_iteration);
+}
+
+void function_listener::ping_generation_end(generation_context<function_solution> & a_context)
+{
+    show_best(a_context.get_stats().getBest(), a_context.get_iteration());
+}
+
+void function_listener::show_best(const function_solution & a_best, size_t a_iteration)
+{
     // save format state of cout
     ios_base::fmtflags save_state = cout.flags();
 
@@ -173,10 +230,10 @@ void function_listener::ping_generation_end(const vector<function_solution> & a_
 
     cout << showpoint << setprecision(8) << showpos;
 
-    for (int n = 0; n < stats.getBest().genes.size(); ++n)
-        cout << right << setw(11) << stats.getBest().genes[n] << ", " ;
+    for (int n = 0; n < a_best.genes.size(); ++n)
+        cout << right << setw(11) << a_best.genes[n] << ", " ;
 
-    cout << noshowpos << "\b\b) = " <<  stats.getBest().value << " [fit = " << stats.getBest().fitness << "]" << endl;
+    cout << noshowpos << "\b\b) = " <<  a_best.value << " [fit = " << a_best.fitness << "]" << endl;
 
     // restore format state of cout
     cout.flags(save_state);
@@ -56,6 +56,7 @@
 #include <vector>
 #include <stdexcept>
 #include <limits>
+#include <utility>
 
 // other elements of Evocosm
 #include "evocosm.h"
@@ -176,6 +177,16 @@ namespace libevocosm
             // nada
         }
 
+        //! Construct from raw genes (move)
+        /*!
+            Constructs a new function solution that takes over a set of genes
+        */
+        function_solution(vector<double> && a_source)
+          : organism< vector<double> >(std::move(a_source)), value(0.0)
+        {
+            // nada
+        }
+
         //! Construct from base class
         /*!
             Constructs a function solution from a base-class object.
@@ -202,6 +213,21 @@ namespace libevocosm
             // nada
         }
 
+        //! Move constructor
+        /*!
+            Creates a new solution that takes over the genes of an existing one.
+            \param a_source - The source object
+        */
+        function_solution(function_solution && a_source)
+          : organism< vector<double> >(std::move(a_source)),
+            value(a_source.value),
+            m_minarg(a_source.m_minarg),
+            m_maxarg(a_source.m_maxarg),
+            m_extent(a_source.m_extent)
+        {
+            // nada
+        }
+
         //! Virtual destructor
         /*!
             Satisfies the requirements of the base class; does nothing
@@ -227,6 +253,22 @@ namespace libevocosm
             return *this;
         }
 
+        //! Move assignment operator
+        /*!
+            Gives a solution the state of another, taking over its genes.
+            \param a_source - The source object
+            \return A reference to <i>this</i>
+        */
+        function_solution & operator = (function_solution && a_source)
+        {
+            organism< vector<double> >::operator = (std::move(a_source));
+            value = a_source.value;
+            m_minarg = a_source.m_minarg;
+            m_maxarg = a_source.m_maxarg;
+            m_extent = a_source.m_extent;
+            return *this;
+        }
+
         //! Comparison operator for algorithms
         /*!
             Returns true if the target object is greater than a_source. While the
@@ -241,6 +283,31 @@ namespace libevocosm
         }
     };
 
+    //! What testing a function_solution records
+    /*!
+        A function_landscape sets a solution's value as well as its fitness, so
+        a fitness cache stores and restores both.
+    */
+    template <>
+    struct test_result<function_solution>
+    {
+        //! The value and the fitness, in that order
+        typedef std::pair<double,double> type;
+
+        //! Copies the results of a test out of a solution
+        static type store(const function_solution & a_organism)
+        {
+            return type(a_organism.value, a_organism.fitness);
+        }
+
+        //! Gives a solution the results of a test
+        static void restore(function_solution & a_organism, const type & a_result)
+        {
+            a_organism.value   = a_result.first;
+            a_organism.fitness = a_result.second;
+        }
+    };
+
     //! Mutates solutions
     /*!
         Implements chance-based mutation of solutions.
@@ -386,10 +453,66 @@ namespace libevocosm
             between two parents. The crossover is implemented on a argument-by-argument basis; in other
             words, crossover occurs between corresponding elements of the parent solutions.
             \param a_population - A population of solutions
-            \param p_limit - Maximum number of children
-            \return A vector containing new "child" chromosomes
+            \param a_limit - Maximum number of children
+            \param a_children - Vector to which children are appended
+            \return <i>true</i>
+        */
+        virtual bool breed(const vector<function_solution> & a_population, size_t a_limit, vector<function_solution> & a_children);
+
+        // the vector-returning form is the base class adapter
+        using reproducer<function_solution>::breed;
+
+    private:
+        // crossover chance
+        double m_crossover_rate;
+    };
+
+    //! Implements reproduction by tournament
+    /*!
+        Breeds solutions like function_reproducer, but chooses parents by
+        tournament instead of a fitness wheel, so it works with unscaled
+        fitness and does no per-generation setup.
+    */
+    class function_tournament_reproducer : public tournament_reproducer<function_solution>, protected fopt_global
+    {
+    public:
+        //! Creation constructor
+        /*!
+            Creates a new reproducer with a given crossover rate.
+            \param a_crossover_rate - Chance that a child has two parents, in the range [0,1]
+            \param a_tournament_size - Number of contestants in each tournament
+        */
+        function_tournament_reproducer(double a_crossover_rate = 1.0, size_t a_tournament_size = 2)
+            : tournament_reproducer<function_solution>(a_tournament_size),
+              m_crossover_rate(a_crossover_rate)
+        {
+            // adjust crossover rate if necessary
+            if (m_crossover_rate > 1.0)
+                m_crossover_rate = 1.0;
+            else if (m_crossover_rate < 0.0)
+                m_crossover_rate = 0.0;
+        }
+
+        //! Gets the crossover rate
+        /*!
+            Returns the crossover rate set for this reproducer.
+            \return Crossover rate
+        */
+        double crossover_rate() const
+        {
+            return m_crossover_rate;
+        }
+
+    protected:
+        //! Create a child
+        /*!
+            Clones the first parent, or, at the crossover rate, combines it
+            argument-by-argument with a second parent chosen by tournament.
+            \param a_population - A population of solutions
+            \param a_parent - Index of the first parent
+            \return A new solution
         */
-        virtual vector<function_solution> breed(const vector<function_solution> & a_population, size_t p_limit);
+        virtual function_solution mate(const vector<function_solution> & a_population, size_t a_parent);
 
     private:
         // crossover chance
@@ -503,6 +626,27 @@ namespace libevocosm
         virtual bool analyze(const vector<function_solution> & a_population,
                              size_t a_iteration,
                              double & a_fitness);
+
+        //! Reports on a population
+        /*!
+            \param a_population - A population of organisms
+            \param a_iteration - Iteration count for this report
+            \return <b>true</b> if evolution should continue; <b>false</b> if not
+        */
+        virtual bool analyze(const vector<function_solution> & a_population, size_t a_iteration);
+
+        //! Reports on a population, with shared statistics
+        /*!
+            Watches the best solution as the other forms do, taking it from the
+            generation's statistics instead of scanning the population again.
+            \param a_context - Population, iteration, and statistics for the generation
+            \return <b>true</b> if evolution should continue; <b>false</b> if not
+        */
+        virtual bool analyze(generation_context<function_solution> & a_context);
+
+    private:
+        // counts generations with the same best solution
+        void track(const function_solution & a_best);
     };
 
     //! An listener implementation that ignores all events
@@ -527,6 +671,17 @@ namespace libevocosm
             \param a_iteration One-based number of the generation ended
         */
         virtual void ping_generation_end(const vector<function_solution> & a_population, size_t a_iteration);
+
+        //! Ping that a generation ends, with shared statistics
+        /*!
+            Ping that processing a generation has ended.
+            \param a_context Population, iteration, and statistics for the generation
+        */
+        virtual void ping_generation_end(generation_context<function_solution> & a_context);
+
+    private:
+        // displays the best solution of a generation
+        void show_best(const function_solution & a_best, size_t a_iteration);
     };
 
     //! A generic function optimizer
@@ -105,6 +105,8 @@ using namespace std;
 #include "fsm_tools.h"
 =======
 #include "machine_tools.h"
+#include "genome_hash.h"
+#include "serializer.h"
 >>>>>>> version 4.0.2
 
 namespace libevocosm
@@ -134,8 +136,8 @@ namespace libevocosm
         //! Defines a transition and output state pair
         struct tranout_t
         {
-            //! The state to be transitioned to
-            roulette_wheel m_new_state;
+            //! The state to be transitioned to; a machine may have many states
+            fenwick_roulette_wheel m_new_state;
 <<<<<<< 53bb9b38239f0b6fb908619d97286ae529277d0b
             
             //! The output value
@@ -219,6 +221,14 @@ namespace libevocosm
         */
         fuzzy_machine(const fuzzy_machine<InSize,OutSize> & a_source);
 
+        //! Move constructor
+        /*!
+            Creates a new fuzzy_machine that takes over the state table of an
+            existing one, leaving the source with no states.
+            \param a_source - Object to be moved
+        */
+        fuzzy_machine(fuzzy_machine<InSize,OutSize> && a_source);
+
         //! Virtual destructor
         /*!
             Does nothing in the base class; exists to allow destruction of derived
@@ -234,6 +244,15 @@ namespace libevocosm
         */
         fuzzy_machine & operator = (const fuzzy_machine<InSize,OutSize> & a_source);
 
+        //  Move assignment
+        /*!
+            Takes over the state table of an existing fuzzy_machine, leaving
+            the source with no states.
+            \param a_source - Object to be moved
+            \return Reference to target object
+        */
+        fuzzy_machine & operator = (fuzzy_machine<InSize,OutSize> && a_source);
+
         //!  Mutation
         /*!
             Mutates a finite state machine object. The four mutations supported are:
@@ -362,6 +381,17 @@ namespace libevocosm
         #endif
 
     private:
+        // selects the constructor that allocates without randomizing
+        struct allocate_only_t { };
+
+        // allocates a table of empty transition slots; used by readers, which must not draw random numbers
+        fuzzy_machine(size_t a_size,
+                      double a_output_base,
+                      double a_output_range,
+                      double a_state_base,
+                      double a_state_range,
+                      allocate_only_t);
+
         // release resources
         void release();
 
@@ -408,6 +438,9 @@ namespace libevocosm
 >>>>>>> version 4.0.2
         //!  Global mutation selector
         static mutation_selector g_selector;
+
+        //!  Checkpoints read and write the table in place
+        friend struct serializer< fuzzy_machine<InSize,OutSize> >;
     };
 
     //  Static initializer
@@ -433,6 +466,34 @@ namespace libevocosm
         delete [] m_state_table;
     }
 
+    // allocate-only constructor
+    template <size_t InSize, size_t OutSize>
+    fuzzy_machine<InSize,OutSize>::fuzzy_machine(size_t a_size,
+                                                 double a_output_base,
+                                                 double a_output_range,
+                                                 double a_state_base,
+                                                 double a_state_range,
+                                                 allocate_only_t)
+      : m_state_table(NULL),
+        m_size(a_size),
+        m_init_state(0),
+        m_current_state(0),
+        m_output_base(a_output_base),
+        m_output_range(a_output_range),
+        m_state_base(a_state_base),
+        m_state_range(a_state_range)
+    {
+        // verify parameters
+        if (m_size < 2)
+            throw std::runtime_error("invalid fuzzy_machine creation parameters");
+
+        // allocate state table, with null transitions so a partial fill releases cleanly
+        m_state_table = new tranout_t ** [m_size];
+
+        for (size_t s = 0; s < m_size; ++s)
+            m_state_table[s] = new tranout_t * [InSize]();
+    }
+
     // deep copy
     template <size_t InSize, size_t OutSize>
     void fuzzy_machine<InSize,OutSize>::deep_copy(const fuzzy_machine<InSize,OutSize> & a_source)
@@ -700,6 +761,23 @@ namespace libevocosm
         deep_copy(a_source);
     }
 
+    //  Move constructor
+    template <size_t InSize, size_t OutSize>
+    fuzzy_machine<InSize,OutSize>::fuzzy_machine(fuzzy_machine<InSize,OutSize> && a_source)
+      : m_state_table(a_source.m_state_table),
+        m_size(a_source.m_size),
+        m_init_state(a_source.m_init_state),
+        m_current_state(a_source.m_current_state),
+        m_output_base(a_source.m_output_base),
+        m_output_range(a_source.m_output_range),
+        m_state_base(a_source.m_state_base),
+        m_state_range(a_source.m_state_range)
+    {
+        // the source gives up its table
+        a_source.m_state_table = NULL;
+        a_source.m_size        = 0;
+    }
+
     //  Virtual destructor
     template <size_t InSize, size_t OutSize>
     fuzzy_machine<InSize,OutSize>::~fuzzy_machine()
@@ -729,6 +807,32 @@ namespace libevocosm
         return *this;
     }
 
+    //  Move assignment
+    template <size_t InSize, size_t OutSize>
+    fuzzy_machine<InSize,OutSize> & fuzzy_machine<InSize,OutSize>::operator = (fuzzy_machine<InSize,OutSize> && a_source)
+    {
+        if (this != &a_source)
+        {
+            // release resources
+            release();
+
+            // take over the source's table
+            m_state_table   = a_source.m_state_table;
+            m_init_state    = a_source.m_init_state;
+            m_current_state = a_source.m_current_state;
+            m_size          = a_source.m_size;
+            m_output_base   = a_source.m_output_base;
+            m_output_range  = a_source.m_output_range;
+            m_state_base    = a_source.m_state_base;
+            m_state_range   = a_source.m_state_range;
+
+            a_source.m_state_table = NULL;
+            a_source.m_size        = 0;
+        }
+
+        return *this;
+    }
+
     //! Set a mutation weight
     template <size_t InSize, size_t OutSize>
     inline void fuzzy_machine<InSize,OutSize>::set_mutation_weight(mutation_id a_type, double a_weight)
@@ -1090,6 +1194,114 @@ namespace libevocosm
         a_stream << "----------" << endl;
     }
     #endif
+
+    //! Hashes a fuzzy_machine
+    /*!
+        Hashes the initial state and the transition weights of a fuzzy_machine;
+        the current state is ignored, since machines are reset before they are tested.
+    */
+    template <size_t InSize, size_t OutSize>
+    struct genome_hash< fuzzy_machine<InSize,OutSize> >
+    {
+        //! Computes the hash
+        /*!
+            \param a_genes - Machine to be hashed
+            \return 64-bit hash of a_genes
+        */
+        uint64_t operator () (const fuzzy_machine<InSize,OutSize> & a_genes) const
+        {
+            uint64_t result = genome_hash_tools::mix(genome_hash_tools::HASH_SEED, (uint64_t)a_genes.size());
+            result = genome_hash_tools::mix(result, (uint64_t)a_genes.init_state());
+
+            for (size_t s = 0; s < a_genes.size(); ++s)
+            {
+                for (size_t i = 0; i < InSize; ++i)
+                {
+                    const typename fuzzy_machine<InSize,OutSize>::tranout_t & tran = a_genes.get_transition(s,i);
+
+                    for (size_t n = 0; n < tran.m_new_state.get_size(); ++n)
+                        result = genome_hash_tools::mix(result, tran.m_new_state.get_weight(n));
+
+                    for (size_t n = 0; n < tran.m_output.get_size(); ++n)
+                        result = genome_hash_tools::mix(result, tran.m_output.get_weight(n));
+                }
+            }
+
+            return result;
+        }
+    };
+
+    //! Serializes a fuzzy_machine
+    template <size_t InSize, size_t OutSize>
+    struct serializer< fuzzy_machine<InSize,OutSize> >
+    {
+        //! Writes a machine
+        static void write(std::ostream & a_stream, const fuzzy_machine<InSize,OutSize> & a_machine)
+        {
+            serializer_tools::write_size(a_stream, a_machine.m_size);
+            serializer_tools::write_size(a_stream, a_machine.m_init_state);
+            serializer_tools::write_size(a_stream, a_machine.m_current_state);
+            serializer<double>::write(a_stream, a_machine.m_output_base);
+            serializer<double>::write(a_stream, a_machine.m_output_range);
+            serializer<double>::write(a_stream, a_machine.m_state_base);
+            serializer<double>::write(a_stream, a_machine.m_state_range);
+
+            for (size_t s = 0; s < a_machine.m_size; ++s)
+            {
+                for (size_t i = 0; i < InSize; ++i)
+                {
+                    const typename fuzzy_machine<InSize,OutSize>::tranout_t & tran = *a_machine.m_state_table[s][i];
+
+                    for (size_t n = 0; n < a_machine.m_size; ++n)
+                        serializer<double>::write(a_stream, tran.m_new_state.get_weight(n));
+
+                    for (size_t n = 0; n < OutSize; ++n)
+                        serializer<double>::write(a_stream, tran.m_output.get_weight(n));
+                }
+            }
+        }
+
+        //! Reads a machine
+        static fuzzy_machine<InSize,OutSize> read(std::istream & a_stream)
+        {
+            size_t size          = serializer_tools::read_count(a_stream, InSize * sizeof(double));
+            size_t init_state    = serializer_tools::read_size(a_stream);
+            size_t current_state = serializer_tools::read_size(a_stream);
+            double output_base   = serializer<double>::read(a_stream);
+            double output_range  = serializer<double>::read(a_stream);
+            double state_base    = serializer<double>::read(a_stream);
+            double state_range   = serializer<double>::read(a_stream);
+
+            if ((init_state >= size) || (current_state >= size))
+                throw std::runtime_error("checkpoint corrupt: fuzzy_machine state out of range");
+
+            // allocate a table of the stored size without touching the random stream
+            fuzzy_machine<InSize,OutSize> result(size, output_base, output_range, state_base, state_range,
+                                                 typename fuzzy_machine<InSize,OutSize>::allocate_only_t());
+
+            result.m_init_state    = init_state;
+            result.m_current_state = current_state;
+
+            vector<double> state_weights(size);
+            vector<double> output_weights(OutSize);
+
+            for (size_t s = 0; s < size; ++s)
+            {
+                for (size_t i = 0; i < InSize; ++i)
+                {
+                    for (size_t n = 0; n < size; ++n)
+                        state_weights[n] = serializer<double>::read(a_stream);
+
+                    for (size_t n = 0; n < OutSize; ++n)
+                        output_weights[n] = serializer<double>::read(a_stream);
+
+                    result.m_state_table[s][i] = new typename fuzzy_machine<InSize,OutSize>::tranout_t(&state_weights[0], size, &output_weights[0]);
+                }
+            }
+
+            return result;
+        }
+    };
 >>>>>>> version 4.0.2
 };
 
@@ -0,0 +1,168 @@
+/*
+    Evocosm is a C++ framework for implementing evolutionary algorithms.
+
+    Copyright 2011 Scott Robert Ladd. All rights reserved.
+
+    Evocosm is user-supported open source software. Its continued development is dependent
+    on financial support from the community. You can provide funding by visiting the Evocosm
+    website at:
+
+        http://www.coyotegulch.com
+
+    You may license Evocosm in one of two fashions:
+
+    1) Simplified BSD License (FreeBSD License)
+
+    Redistribution and use in source and binary forms, with or without modification, are
+    permitted provided that the following conditions are met:
+
+    1.  Redistributions of source code must retain the above copyright notice, this list of
+        conditions and the following disclaimer.
+
+    2.  Redistributions in binary form must reproduce the above copyright notice, this list
+        of conditions and the following disclaimer in the documentation and/or other materials
+        provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY SCOTT ROBERT LADD ``AS IS'' AND ANY EXPRESS OR IMPLIED
+    WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+    FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SCOTT ROBERT LADD OR
+    CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+    ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+    The views and conclusions contained in the software and documentation are those of the
+    authors and should not be interpreted as representing official policies, either expressed
+    or implied, of Scott Robert Ladd.
+
+    2) Closed-Source Proprietary License
+
+    If your project is a closed-source or proprietary project, the Simplified BSD License may
+    not be appropriate or desirable. In such cases, contact the Evocosm copyright holder to
+    arrange your purchase of an appropriate license.
+
+    The author can be contacted at:
+
+          scott.ladd@coyotegulch.com
+          scott.ladd@gmail.com
+          http:www.coyotegulch.com
+*/
+
+#if !defined(LIBEVOCOSM_GENERATION_CONTEXT_H)
+#define LIBEVOCOSM_GENERATION_CONTEXT_H
+
+// Standard C++ Library
+#include <cstddef>
+#include <vector>
+
+// libevocosm
+#include "stats.h"
+
+namespace libevocosm
+{
+    using std::vector;
+
+    //! Information shared by the phases of a generation
+    /*!
+        An evocosm creates a generation_context for each generation, and passes
+        it to the listener, analyzer, scaler, and selector. The context computes
+        fitness statistics the first time any of them asks, and hands the same
+        statistics to the rest, so the population is scanned once rather than
+        once per operator.
+        <p>
+        Anything that changes fitness values must invalidate the context, so the
+        next request recomputes the statistics; the evocosm does so after testing
+        and after scaling. Operators handed a context must not change fitness
+        themselves, except for a scaler.
+        \param OrganismType - The type of organism
+    */
+    template <class OrganismType>
+    class generation_context
+    {
+    public:
+        //! Constructor
+        /*!
+            Creates a context for a population. No statistics are computed yet.
+            \param a_population - The population, which must exist while the context does
+            \param a_iteration - One-based number of the generation
+        */
+        generation_context(const vector<OrganismType> & a_population, size_t a_iteration)
+          : m_population(a_population),
+            m_iteration(a_iteration),
+            m_stats(NULL)
+        {
+            // nada
+        }
+
+        //! Destructor
+        ~generation_context()
+        {
+            delete m_stats;
+        }
+
+        //! Get the population
+        const vector<OrganismType> & get_population() const
+        {
+            return m_population;
+        }
+
+        //! Get the iteration
+        /*!
+            \return One-based number of the generation
+        */
+        size_t get_iteration() const
+        {
+            return m_iteration;
+        }
+
+        //! Get fitness statistics
+        /*!
+            Returns statistics for the population's current fitness values,
+            computing them if this is the first request since the context was
+            created or invalidated.
+            \return Statistics for the population
+        */
+        const fitness_stats<OrganismType> & get_stats()
+        {
+            if (m_stats == NULL)
+                m_stats = new fitness_stats<OrganismType>(m_population);
+
+            return *m_stats;
+        }
+
+        //! Are statistics available without a scan?
+        bool has_stats() const
+        {
+            return m_stats != NULL;
+        }
+
+        //! Discard statistics
+        /*!
+            Call after changing fitness values; the next call to get_stats
+            recomputes them.
+        */
+        void invalidate()
+        {
+            delete m_stats;
+            m_stats = NULL;
+        }
+
+    private:
+        // no copying
+        generation_context(const generation_context & a_source);
+        generation_context & operator = (const generation_context & a_source);
+
+        // the population described
+        const vector<OrganismType> & m_population;
+
+        // generation number
+        size_t m_iteration;
+
+        // statistics, if they've been computed
+        fitness_stats<OrganismType> * m_stats;
+    };
+};
+
+#endif
@@ -0,0 +1,145 @@
+/*
+    Evocosm is a C++ framework for implementing evolutionary algorithms.
+
+    Copyright 2011 Scott Robert Ladd. All rights reserved.
+
+    Evocosm is user-supported open source software. Its continued development is dependent
+    on financial support from the community. You can provide funding by visiting the Evocosm
+    website at:
+
+        http://www.coyotegulch.com
+
+    You may license Evocosm in one of two fashions:
+
+    1) Simplified BSD License (FreeBSD License)
+
+    Redistribution and use in source and binary forms, with or without modification, are
+    permitted provided that the following conditions are met:
+
+    1.  Redistributions of source code must retain the above copyright notice, this list of
+        conditions and the following disclaimer.
+
+    2.  Redistributions in binary form must reproduce the above copyright notice, this list
+        of conditions and the following disclaimer in the documentation and/or other materials
+        provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY SCOTT ROBERT LADD ``AS IS'' AND ANY EXPRESS OR IMPLIED
+    WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+    FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SCOTT ROBERT LADD OR
+    CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+    ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+    The views and conclusions contained in the software and documentation are those of the
+    authors and should not be interpreted as representing official policies, either expressed
+    or implied, of Scott Robert Ladd.
+
+    2) Closed-Source Proprietary License
+
+    If your project is a closed-source or proprietary project, the Simplified BSD License may
+    not be appropriate or desirable. In such cases, contact the Evocosm copyright holder to
+    arrange your purchase of an appropriate license.
+
+    The author can be contacted at:
+
+          scott.ladd@coyotegulch.com
+          scott.ladd@gmail.com
+          http:www.coyotegulch.com
+*/
+
+#if !defined(LIBEVOCOSM_GENOME_HASH_H)
+#define LIBEVOCOSM_GENOME_HASH_H
+
+// Standard C++ Library
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace libevocosm
+{
+    //! Hashes a genotype
+    /*!
+        A genome hash reduces an organism's genes to a 64-bit value, so that a
+        fitness_cache can recognize genes it has seen before. Equal genes must
+        produce equal hashes; with 64 bits, different genes are very unlikely
+        to collide. The primary template is declared but not defined: a
+        genotype must provide a specialization before it can be cached.
+        Specializations for floating-point vectors and the state machines live
+        beside the types they hash.
+        \param Genotype - The type of genes being hashed
+    */
+    template <typename Genotype>
+    struct genome_hash;
+
+    //! Tools for writing genome hashes
+    class genome_hash_tools
+    {
+    public:
+        //! Starting value for a hash
+        static const uint64_t HASH_SEED = 0xCBF29CE484222325ULL;
+
+        //! Folds a value into a hash
+        /*!
+            Mixes a 64-bit value into a running hash, such that the result
+            depends on the order in which values are folded in.
+            \param a_hash - The running hash
+            \param a_value - Value to fold into the hash
+            \return The new running hash
+        */
+        static uint64_t mix(uint64_t a_hash, uint64_t a_value)
+        {
+            // splitmix64 finalizer applied to the combined value
+            uint64_t z = (a_hash ^ a_value) * 0x9E3779B97F4A7C15ULL + (a_hash << 6) + (a_hash >> 2);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+
+        //! Folds a double into a hash
+        /*!
+            Mixes the bit pattern of a double into a running hash. Zero and
+            negative zero hash alike.
+            \param a_hash - The running hash
+            \param a_value - Value to fold into the hash
+            \return The new running hash
+        */
+        static uint64_t mix(uint64_t a_hash, double a_value)
+        {
+            uint64_t bits = 0;
+
+            if (a_value != 0.0)
+                memcpy(&bits, &a_value, sizeof(bits));
+
+            return mix(a_hash, bits);
+        }
+    };
+
+    //! Hashes a vector of doubles
+    /*!
+        Hashes the genes of floating-point organisms, such as function_solution.
+    */
+    template <>
+    struct genome_hash< std::vector<double> >
+    {
+        //! Computes the hash
+        /*!
+            \param a_genes - Genes to be hashed
+            \return 64-bit hash of a_genes
+        */
+        uint64_t operator () (const std::vector<double> & a_genes) const
+        {
+            uint64_t result = genome_hash_tools::mix(genome_hash_tools::HASH_SEED, (uint64_t)a_genes.size());
+
+            for (std::vector<double>::const_iterator gene = a_genes.begin(); gene != a_genes.end(); ++gene)
+                result = genome_hash_tools::mix(result, *gene);
+
+            return result;
+        }
+    };
+};
+
+#endif
@@ -0,0 +1,204 @@
+/*
+    Evocosm is a C++ framework for implementing evolutionary algorithms.
+
+    Copyright 2011 Scott Robert Ladd. All rights reserved.
+
+    Evocosm is user-supported open source software. Its continued development is dependent
+    on financial support from the community. You can provide funding by visiting the Evocosm
+    website at:
+
+        http://www.coyotegulch.com
+
+    You may license Evocosm in one of two fashions:
+
+    1) Simplified BSD License (FreeBSD License)
+
+    Redistribution and use in source and binary forms, with or without modification, are
+    permitted provided that the following conditions are met:
+
+    1.  Redistributions of source code must retain the above copyright notice, this list of
+        conditions and the following disclaimer.
+
+    2.  Redistributions in binary form must reproduce the above copyright notice, this list
+        of conditions and the following disclaimer in the documentation and/or other materials
+        provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY SCOTT ROBERT LADD ``AS IS'' AND ANY EXPRESS OR IMPLIED
+    WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+    FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SCOTT ROBERT LADD OR
+    CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+    ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+    The views and conclusions contained in the software and documentation are those of the
+    authors and should not be interpreted as representing official policies, either expressed
+    or implied, of Scott Robert Ladd.
+
+    2) Closed-Source Proprietary License
+
+    If your project is a closed-source or proprietary project, the Simplified BSD License may
+    not be appropriate or desirable. In such cases, contact the Evocosm copyright holder to
+    arrange your purchase of an appropriate license.
+
+    The author can be contacted at:
+
+          scott.ladd@coyotegulch.com
+          scott.ladd@gmail.com
+          http:www.coyotegulch.com
+*/
+
+// Standard C++ Library
+#include <new>
+
+// libevocosm
+#include "genome_pool.h"
+using namespace libevocosm;
+
+// pooling is off until enabled
+std::atomic<bool> genome_pool::g_enabled(false);
+
+// batches shared by all threads
+genome_pool::block_map genome_pool::g_depot;
+std::mutex genome_pool::g_depot_lock;
+
+// each thread's blocks
+thread_local genome_pool::thread_cache genome_pool::t_cache;
+thread_local bool genome_pool::t_done = false;
+
+// a thread's blocks go back to the heap when it ends
+genome_pool::thread_cache::~thread_cache()
+{
+    free_all(m_blocks);
+    t_done = true;
+}
+
+// allocates a block
+void * genome_pool::allocate(size_t a_bytes)
+{
+    if (g_enabled && !t_done)
+    {
+        block_list & blocks = t_cache.m_blocks[a_bytes];
+
+        if (blocks.empty())
+            take_batch(a_bytes, blocks);
+
+        if (!blocks.empty())
+        {
+            void * result = blocks.back();
+            blocks.pop_back();
+            return result;
+        }
+    }
+
+    return ::operator new(a_bytes);
+}
+
+// frees a block
+void genome_pool::release(void * a_block, size_t a_bytes)
+{
+    if (a_block == NULL)
+        return;
+
+    if (!g_enabled || t_done)
+    {
+        ::operator delete(a_block);
+        return;
+    }
+
+    block_list & blocks = t_cache.m_blocks[a_bytes];
+    blocks.push_back(a_block);
+
+    // keep one batch on hand; share the rest
+    if (blocks.size() >= 2 * BATCH_SIZE)
+    {
+        block_list batch(blocks.end() - BATCH_SIZE, blocks.end());
+        blocks.resize(blocks.size() - BATCH_SIZE);
+        give_batch(a_bytes, batch);
+    }
+}
+
+// hands the calling thread's blocks to the depot
+void genome_pool::flush()
+{
+    if (t_done)
+        return;
+
+    for (block_map::iterator size = t_cache.m_blocks.begin(); size != t_cache.m_blocks.end(); ++size)
+    {
+        block_list & blocks = size->second;
+
+        // the depot takes whole batches only
+        while (blocks.size() >= BATCH_SIZE)
+        {
+            block_list batch(blocks.end() - BATCH_SIZE, blocks.end());
+            blocks.resize(blocks.size() - BATCH_SIZE);
+            give_batch(size->first, batch);
+        }
+    }
+
+    free_all(t_cache.m_blocks);
+}
+
+// returns pooled blocks to the heap
+void genome_pool::trim()
+{
+    if (!t_done)
+        free_all(t_cache.m_blocks);
+
+    std::lock_guard<std::mutex> lock(g_depot_lock);
+    free_all(g_depot);
+}
+
+// take a batch from the depot
+bool genome_pool::take_batch(size_t a_bytes, block_list & a_blocks)
+{
+    std::lock_guard<std::mutex> lock(g_depot_lock);
+
+    block_map::iterator depot = g_depot.find(a_bytes);
+
+    if ((depot == g_depot.end()) || depot->second.empty())
+        return false;
+
+    // the depot holds whole batches, so moving BATCH_SIZE blocks empties none partway
+    block_list & shared = depot->second;
+    a_blocks.insert(a_blocks.end(), shared.end() - BATCH_SIZE, shared.end());
+    shared.resize(shared.size() - BATCH_SIZE);
+    return true;
+}
+
+// give a batch to the depot
+void genome_pool::give_batch(size_t a_bytes, block_list & a_blocks)
+{
+    {
+        std::lock_guard<std::mutex> lock(g_depot_lock);
+        block_list & shared = g_depot[a_bytes];
+
+        if (shared.size() < MAX_DEPOT_BATCHES * BATCH_SIZE)
+        {
+            shared.insert(shared.end(), a_blocks.begin(), a_blocks.end());
+            a_blocks.clear();
+            return;
+        }
+    }
+
+    // the depot is full
+    for (size_t n = 0; n < a_blocks.size(); ++n)
+        ::operator delete(a_blocks[n]);
+
+    a_blocks.clear();
+}
+
+// free every block in a map
+void genome_pool::free_all(block_map & a_blocks)
+{
+    for (block_map::iterator size = a_blocks.begin(); size != a_blocks.end(); ++size)
+    {
+        for (size_t n = 0; n < size->second.size(); ++n)
+            ::operator delete(size->second[n]);
+    }
+
+    a_blocks.clear();
+}
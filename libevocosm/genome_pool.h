@@ -0,0 +1,191 @@
+/*
+    Evocosm is a C++ framework for implementing evolutionary algorithms.
+
+    Copyright 2011 Scott Robert Ladd. All rights reserved.
+
+    Evocosm is user-supported open source software. Its continued development is dependent
+    on financial support from the community. You can provide funding by visiting the Evocosm
+    website at:
+
+        http://www.coyotegulch.com
+
+    You may license Evocosm in one of two fashions:
+
+    1) Simplified BSD License (FreeBSD License)
+
+    Redistribution and use in source and binary forms, with or without modification, are
+    permitted provided that the following conditions are met:
+
+    1.  Redistributions of source code must retain the above copyright notice, this list of
+        conditions and the following disclaimer.
+
+    2.  Redistributions in binary form must reproduce the above copyright notice, this list
+        of conditions and the following disclaimer in the documentation and/or other materials
+        provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY SCOTT ROBERT LADD ``AS IS'' AND ANY EXPRESS OR IMPLIED
+    WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+    FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SCOTT ROBERT LADD OR
+    CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+    ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+    The views and conclusions contained in the software and documentation are those of the
+    authors and should not be interpreted as representing official policies, either expressed
+    or implied, of Scott Robert Ladd.
+
+    2) Closed-Source Proprietary License
+
+    If your project is a closed-source or proprietary project, the Simplified BSD License may
+    not be appropriate or desirable. In such cases, contact the Evocosm copyright holder to
+    arrange your purchase of an appropriate license.
+
+    The author can be contacted at:
+
+          scott.ladd@coyotegulch.com
+          scott.ladd@gmail.com
+          http:www.coyotegulch.com
+*/
+
+#if !defined(LIBEVOCOSM_GENOME_POOL_H)
+#define LIBEVOCOSM_GENOME_POOL_H
+
+// Standard C++ Library
+#include <cstddef>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+
+namespace libevocosm
+{
+    //! Recycles the memory that holds genomes
+    /*!
+        Every generation destroys most of its organisms and creates as many
+        children, each of which allocates its genome from the heap. Most of
+        those allocations are the same size as one just freed, so the pool
+        keeps freed blocks and hands them to the next genome of that size;
+        after the first few generations, turnover costs almost no calls to
+        the heap, and its lock is not contended when many threads breed.
+        <p>
+        An arena freed wholesale at turnover would not work here: survivors
+        and the organisms in an island's outbox outlive their generation.
+        The pool gets the same effect by recycling blocks one at a time.
+        <p>
+        Each thread keeps its own blocks, sorted by size. When a thread holds
+        more than it needs, it moves a batch to a shared depot; a thread that
+        runs out takes a batch from the depot before going to the heap, so
+        blocks freed by one thread and needed by another still recycle. The
+        pool is off until enabled, and may be switched at any time; blocks
+        always come from operator new, so they are safe to free either way.
+    */
+    class genome_pool
+    {
+    public:
+        //! Enables or disables pooling
+        /*!
+            Blocks already pooled are kept when pooling is disabled; call trim
+            to return them to the heap.
+            \param a_enabled - Should freed blocks be kept for reuse?
+        */
+        static void set_enabled(bool a_enabled)
+        {
+            g_enabled = a_enabled;
+        }
+
+        //! Is pooling enabled?
+        /*!
+            \return True if freed blocks are kept for reuse
+        */
+        static bool is_enabled()
+        {
+            return g_enabled;
+        }
+
+        //! Allocates a block
+        /*!
+            Takes a pooled block of the given size if one is available.
+            \param a_bytes - Size of the block
+            \return A block suitably aligned for any type
+        */
+        static void * allocate(size_t a_bytes);
+
+        //! Frees a block
+        /*!
+            Keeps the block for reuse if pooling is enabled.
+            \param a_block - A block returned by allocate; may be NULL
+            \param a_bytes - The size given to allocate
+        */
+        static void release(void * a_block, size_t a_bytes);
+
+        //! Hands the calling thread's blocks to the depot
+        /*!
+            Moves the blocks the calling thread holds to the shared depot, in
+            whole batches, where other threads can take them and trim can free
+            them; blocks that do not fill a batch go back to the heap. A thread
+            that allocates genomes for others, such as a breeding thread, calls
+            this when it finishes; the evocosm does so for its breeding threads
+            at the end of each generation's breeding.
+        */
+        static void flush();
+
+        //! Returns pooled blocks to the heap
+        /*!
+            Frees the blocks held by the calling thread and by the depot. Other
+            threads' blocks are not touched: they are freed when those threads
+            end, or reach the depot when those threads call flush. Once an
+            evocosm's run_generation returns, its breeding threads hold none.
+        */
+        static void trim();
+
+    private:
+        // blocks of one size
+        typedef std::vector<void *> block_list;
+
+        // blocks of every size, keyed by size in bytes
+        typedef std::unordered_map<size_t, block_list> block_map;
+
+        // the blocks kept by one thread
+        struct thread_cache
+        {
+            block_map m_blocks;
+
+            ~thread_cache();
+        };
+
+        // blocks moved between a thread and the depot at a time
+        static const size_t BATCH_SIZE = 64;
+
+        // most batches of one size kept by the depot
+        static const size_t MAX_DEPOT_BATCHES = 1024;
+
+        // take a batch from the depot; returns false if it has none
+        static bool take_batch(size_t a_bytes, block_list & a_blocks);
+
+        // give a batch to the depot, or free it if the depot is full
+        static void give_batch(size_t a_bytes, block_list & a_blocks);
+
+        // free every block in a map
+        static void free_all(block_map & a_blocks);
+
+        // is pooling enabled?
+        static std::atomic<bool> g_enabled;
+
+        // batches shared by all threads
+        static block_map g_depot;
+
+        // protects g_depot
+        static std::mutex g_depot_lock;
+
+        // the calling thread's blocks
+        static thread_local thread_cache t_cache;
+
+        // set once t_cache is destroyed, so genomes that outlive it go to the heap
+        static thread_local bool t_done;
+    };
+};
+
+#endif
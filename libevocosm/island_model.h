@@ -0,0 +1,603 @@
+/*
+    Evocosm is a C++ framework for implementing evolutionary algorithms.
+
+    Copyright 2011 Scott Robert Ladd. All rights reserved.
+
+    Evocosm is user-supported open source software. Its continued development is dependent
+    on financial support from the community. You can provide funding by visiting the Evocosm
+    website at:
+
+        http://www.coyotegulch.com
+
+    You may license Evocosm in one of two fashions:
+
+    1) Simplified BSD License (FreeBSD License)
+
+    Redistribution and use in source and binary forms, with or without modification, are
+    permitted provided that the following conditions are met:
+
+    1.  Redistributions of source code must retain the above copyright notice, this list of
+        conditions and the following disclaimer.
+
+    2.  Redistributions in binary form must reproduce the above copyright notice, this list
+        of conditions and the following disclaimer in the documentation and/or other materials
+        provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY SCOTT ROBERT LADD ``AS IS'' AND ANY EXPRESS OR IMPLIED
+    WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+    FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SCOTT ROBERT LADD OR
+    CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+    ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+    The views and conclusions contained in the software and documentation are those of the
+    authors and should not be interpreted as representing official policies, either expressed
+    or implied, of Scott Robert Ladd.
+
+    2) Closed-Source Proprietary License
+
+    If your project is a closed-source or proprietary project, the Simplified BSD License may
+    not be appropriate or desirable. In such cases, contact the Evocosm copyright holder to
+    arrange your purchase of an appropriate license.
+
+    The author can be contacted at:
+
+          scott.ladd@coyotegulch.com
+          scott.ladd@gmail.com
+          http:www.coyotegulch.com
+*/
+
+#if !defined(LIBEVOCOSM_ISLAND_MODEL_H)
+#define LIBEVOCOSM_ISLAND_MODEL_H
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+// Standard C++ Library
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+// libevocosm
+#include "evocosm.h"
+
+namespace libevocosm
+{
+    using std::vector;
+
+    //! A single-producer, single-consumer queue of migrating organisms
+    /*!
+        A fixed-size ring buffer that carries organisms from one island to
+        another without locks: only the source island's thread pushes, and only
+        the destination island's thread pops. When the buffer is full, new
+        emigrants are turned away rather than waiting for room.
+        \param OrganismType - The type of organism that migrates
+    */
+    template <class OrganismType>
+    class migration_channel
+    {
+    public:
+        //! Constructor
+        /*!
+            Creates an empty channel.
+            \param a_capacity - Maximum number of organisms in transit
+        */
+        migration_channel(size_t a_capacity)
+          : m_slots(a_capacity + 1),
+            m_head(0),
+            m_tail(0)
+        {
+            // nada
+        }
+
+        //! Send an organism
+        /*!
+            Called only by the source island's thread.
+            \param a_organism - The emigrant, which is moved into the channel
+            \return <i>false</i> if the channel is full and a_organism was not sent
+        */
+        bool push(OrganismType & a_organism)
+        {
+            size_t tail = m_tail.load(std::memory_order_relaxed);
+            size_t next = (tail + 1) % m_slots.size();
+
+            if (next == m_head.load(std::memory_order_acquire))
+                return false;
+
+            m_slots[tail] = std::move(a_organism);
+            m_tail.store(next, std::memory_order_release);
+            return true;
+        }
+
+        //! Receive an organism
+        /*!
+            Called only by the destination island's thread.
+            \param a_organism - Receives the immigrant
+            \return <i>false</i> if the channel is empty
+        */
+        bool pop(OrganismType & a_organism)
+        {
+            size_t head = m_head.load(std::memory_order_relaxed);
+
+            if (head == m_tail.load(std::memory_order_acquire))
+                return false;
+
+            a_organism = std::move(m_slots[head]);
+            m_head.store((head + 1) % m_slots.size(), std::memory_order_release);
+            return true;
+        }
+
+    private:
+        // no copying
+        migration_channel(const migration_channel & a_source);
+        migration_channel & operator = (const migration_channel & a_source);
+
+        // organisms in transit; one slot is always empty
+        vector<OrganismType> m_slots;
+
+        // next slot to be read, owned by the consumer
+        std::atomic<size_t> m_head;
+
+        // keep the consumer's and producer's indices on separate cache lines
+        char m_padding[64];
+
+        // next slot to be written, owned by the producer
+        std::atomic<size_t> m_tail;
+    };
+
+    //! Paths along which organisms migrate between islands
+    enum migration_topology
+    {
+        MIGRATE_RING,   //!< Each island sends emigrants to the next, and the last to the first
+        MIGRATE_FULL,   //!< Each island sends emigrants to every other island
+        MIGRATE_RANDOM  //!< Each island sends emigrants to a randomly-chosen other island
+    };
+
+    //! Evolves several populations concurrently, with migration between them
+    /*!
+        An island model evolves a set of evocosms ("islands") independently,
+        each on its own thread, occasionally copying the best organisms of one
+        island into others. Isolation preserves diversity; migration spreads
+        good genes. Since islands only interact through migration, an island
+        model scales well on many-core machines even when testing a single
+        organism is too cheap to be worth parallelizing.
+
+        Every few generations (the migration interval), an island copies its
+        best organisms into channels leading to its neighbors, as defined by
+        the topology, and replaces its worst organisms with any immigrants that
+        have arrived. Islands never wait for one another; an island that runs
+        ahead simply finds fewer immigrants.
+        <p>
+        Migration happens through each island's test hook (see test_hook), right
+        after the island's population is tested and before it is scaled. Every
+        organism then holds the raw fitness of its own test, so the best and
+        worst are those the landscape says they are, and immigrants compete on
+        the same terms as natives -- which assumes the islands share a landscape,
+        or at least a measure of fitness. The model sets each island's test hook,
+        and removes it when the model is destroyed.
+
+        Each island must be a separate evocosm with its own population. The
+        islands may share landscapes and other components only if those
+        components can safely be used by several threads at once; the stateless
+        operators supplied with Evocosm can be, but a fitness_cache can not. An
+        island's own landscape test should normally run serially (see
+        evocosm::set_num_threads), and so should its breeding (see
+        evocosm::set_breed_threads), since the islands already occupy the threads.
+
+        Without OpenMP, or when fewer threads are available than islands, the
+        islands take turns on the available threads, one generation at a time.
+        \param OrganismType - The type of organism
+    */
+    template <class OrganismType>
+    class island_model : protected globals
+    {
+    public:
+        //! Constructor
+        /*!
+            Creates an island model from a set of evocosms.
+            \param a_islands - The islands; each must exist while the model uses it
+            \param a_topology - Paths along which organisms migrate
+            \param a_interval - Number of generations between migrations; zero disables migration
+            \param a_emigrants - Number of organisms each island sends along each path
+        */
+        island_model(const vector< evocosm<OrganismType> * > & a_islands,
+                     migration_topology a_topology = MIGRATE_RING,
+                     size_t a_interval  = 10,
+                     size_t a_emigrants = 2)
+          : m_islands(a_islands),
+            m_topology(a_topology),
+            m_interval(a_interval),
+            m_emigrants(a_emigrants),
+            m_hooks(),
+            m_channels(),
+            m_generations(a_islands.size(), 0),
+            m_sent(0),
+            m_received(0),
+            m_dropped(0),
+            m_stop(false)
+        {
+            // give each island's generations their own random streams, and
+            // migrate when an island has been tested
+            for (size_t i = 0; i < m_islands.size(); ++i)
+            {
+                m_islands[i]->set_stream_id(i);
+
+                m_hooks.push_back(new island_hook(*this, i));
+                m_islands[i]->set_test_hook(m_hooks[i]);
+            }
+
+            create_channels();
+        }
+
+        //! Destructor
+        virtual ~island_model()
+        {
+            for (size_t i = 0; i < m_islands.size(); ++i)
+            {
+                if (m_islands[i]->get_test_hook() == m_hooks[i])
+                    m_islands[i]->set_test_hook(NULL);
+
+                delete m_hooks[i];
+            }
+
+            release_channels();
+        }
+
+        //! Run the islands
+        /*!
+            Runs each island for a number of generations, or until any island's
+            analyzer decides evolution is complete.
+            \param a_generations - Number of generations for each island
+            \return <i>true</i> if evolution should continue; <i>false</i> if an island's run is complete
+        */
+        bool run(size_t a_generations)
+        {
+            int num_islands = (int)m_islands.size();
+
+            if (num_islands == 0)
+                return false;
+
+            m_stop = false;
+
+          #if defined(_OPENMP)
+            #pragma omp parallel num_threads(num_islands)
+          #endif
+            {
+              #if defined(_OPENMP)
+                int thread      = omp_get_thread_num();
+                int num_threads = omp_get_num_threads();
+              #else
+                int thread      = 0;
+                int num_threads = 1;
+              #endif
+
+                // run this thread's islands a generation at a time
+                for (size_t g = 0; (g < a_generations) && !m_stop; ++g)
+                {
+                    // each island's generations draw from its own random streams
+                    for (int i = thread; i < num_islands; i += num_threads)
+                        step(i);
+                }
+            }
+
+            return !m_stop;
+        }
+
+        //! Get the number of islands
+        size_t get_num_islands() const
+        {
+            return m_islands.size();
+        }
+
+        //! Get an island
+        /*!
+            \param a_index - Index of an island
+            \return The evocosm for island a_index
+        */
+        evocosm<OrganismType> & get_island(size_t a_index)
+        {
+            return *m_islands[a_index];
+        }
+
+        //! Get the migration topology
+        migration_topology get_topology() const
+        {
+            return m_topology;
+        }
+
+        //! Set the migration topology
+        /*!
+            Changes the migration paths; organisms in transit are discarded.
+            Must not be called while the islands are running.
+            \param a_topology - New topology
+        */
+        void set_topology(migration_topology a_topology)
+        {
+            m_topology = a_topology;
+            release_channels();
+            create_channels();
+        }
+
+        //! Get the migration interval
+        size_t get_interval() const
+        {
+            return m_interval;
+        }
+
+        //! Set the migration interval
+        /*!
+            \param a_interval - Number of generations between migrations; zero disables migration
+        */
+        void set_interval(size_t a_interval)
+        {
+            m_interval = a_interval;
+        }
+
+        //! Get the number of emigrants
+        size_t get_emigrants() const
+        {
+            return m_emigrants;
+        }
+
+        //! Set the number of emigrants
+        /*!
+            Changes the number of organisms sent along each path; organisms in
+            transit are discarded. Must not be called while the islands are running.
+            \param a_emigrants - Number of organisms each island sends along each path
+        */
+        void set_emigrants(size_t a_emigrants)
+        {
+            m_emigrants = a_emigrants;
+            release_channels();
+            create_channels();
+        }
+
+        //! Get the number of organisms sent
+        size_t get_sent() const
+        {
+            return m_sent;
+        }
+
+        //! Get the number of organisms received
+        size_t get_received() const
+        {
+            return m_received;
+        }
+
+        //! Get the number of organisms turned away by full channels
+        size_t get_dropped() const
+        {
+            return m_dropped;
+        }
+
+    private:
+        // no copying
+        island_model(const island_model & a_source);
+        island_model & operator = (const island_model & a_source);
+
+        // batches of emigrants a channel can hold
+        static const size_t CHANNEL_BATCHES = 4;
+
+        // channel from one island to another; NULL if the topology has no such path
+        migration_channel<OrganismType> * channel(size_t a_from, size_t a_to)
+        {
+            return m_channels[a_from * m_islands.size() + a_to];
+        }
+
+        // create channels for the current topology
+        void create_channels()
+        {
+            size_t n = m_islands.size();
+
+            m_channels.assign(n * n, NULL);
+
+            for (size_t from = 0; from < n; ++from)
+            {
+                for (size_t to = 0; to < n; ++to)
+                {
+                    if ((from == to) || ((m_topology == MIGRATE_RING) && (to != (from + 1) % n)))
+                        continue;
+
+                    m_channels[from * n + to] = new migration_channel<OrganismType>(m_emigrants * CHANNEL_BATCHES);
+                }
+            }
+        }
+
+        // delete all channels
+        void release_channels()
+        {
+            for (size_t n = 0; n < m_channels.size(); ++n)
+                delete m_channels[n];
+
+            m_channels.clear();
+        }
+
+        // migrates an island's organisms once the island has been tested
+        class island_hook : public test_hook<OrganismType>
+        {
+        public:
+            island_hook(island_model & a_model, size_t a_island)
+              : m_model(a_model),
+                m_island(a_island)
+            {
+                // nada
+            }
+
+            virtual void tested(vector<OrganismType> & a_population, size_t a_iteration)
+            {
+                m_model.migrate(m_island, a_population);
+            }
+
+        private:
+            island_model & m_model;
+            size_t m_island;
+        };
+
+        // run one generation of an island; it migrates through its test hook
+        void step(size_t a_island)
+        {
+            ++m_generations[a_island];
+
+            if (!m_islands[a_island]->run_generation())
+                m_stop = true;
+        }
+
+        // exchange organisms with other islands, if it's time
+        void migrate(size_t a_island, vector<OrganismType> & a_population)
+        {
+            if ((m_interval > 0) && (m_emigrants > 0) && (m_islands.size() > 1) && ((m_generations[a_island] % m_interval) == 0))
+            {
+                emigrate(a_island, a_population);
+                immigrate(a_island, a_population);
+            }
+        }
+
+        // compare organisms by fitness, best first
+        struct fitter
+        {
+            const vector<OrganismType> & m_population;
+
+            fitter(const vector<OrganismType> & a_population)
+              : m_population(a_population)
+            {
+                // nada
+            }
+
+            bool operator () (size_t a_left, size_t a_right) const
+            {
+                return m_population[a_left].fitness > m_population[a_right].fitness;
+            }
+        };
+
+        // indices of a population, ordered so that the first a_count are the best
+        static vector<size_t> rank(const vector<OrganismType> & a_population, size_t a_count)
+        {
+            vector<size_t> result(a_population.size());
+
+            for (size_t n = 0; n < result.size(); ++n)
+                result[n] = n;
+
+            a_count = std::min(a_count, result.size());
+            std::partial_sort(result.begin(), result.begin() + a_count, result.end(), fitter(a_population));
+
+            return result;
+        }
+
+        // send copies of an island's best organisms to its neighbors
+        void emigrate(size_t a_island, const vector<OrganismType> & a_population)
+        {
+            size_t n = m_islands.size();
+
+            vector<size_t> best = rank(a_population, m_emigrants);
+            size_t count = std::min(m_emigrants, a_population.size());
+
+            // pick destinations
+            vector<size_t> destinations;
+
+            switch (m_topology)
+            {
+                case MIGRATE_RING:
+                    destinations.push_back((a_island + 1) % n);
+                    break;
+
+                case MIGRATE_FULL:
+                    for (size_t to = 0; to < n; ++to)
+                    {
+                        if (to != a_island)
+                            destinations.push_back(to);
+                    }
+                    break;
+
+                case MIGRATE_RANDOM:
+                {
+                    size_t to = g_random.get_index(n - 1);
+                    destinations.push_back((to < a_island) ? to : to + 1);
+                    break;
+                }
+            }
+
+            // send them
+            for (size_t d = 0; d < destinations.size(); ++d)
+            {
+                migration_channel<OrganismType> * path = channel(a_island, destinations[d]);
+
+                for (size_t e = 0; e < count; ++e)
+                {
+                    OrganismType emigrant(a_population[best[e]]);
+
+                    if (path->push(emigrant))
+                        ++m_sent;
+                    else
+                        ++m_dropped;
+                }
+            }
+        }
+
+        // replace an island's worst organisms with organisms that have arrived
+        void immigrate(size_t a_island, vector<OrganismType> & a_population)
+        {
+            vector<OrganismType> arrivals;
+            OrganismType immigrant;
+
+            for (size_t from = 0; from < m_islands.size(); ++from)
+            {
+                migration_channel<OrganismType> * path = channel(from, a_island);
+
+                if (path == NULL)
+                    continue;
+
+                while (path->pop(immigrant))
+                    arrivals.push_back(std::move(immigrant));
+            }
+
+            if (arrivals.empty())
+                return;
+
+            // the worst organisms are at the end of the ranking
+            size_t count = std::min(arrivals.size(), a_population.size());
+            vector<size_t> ranking = rank(a_population, a_population.size() - count);
+
+            for (size_t n = 0; n < count; ++n)
+                a_population[ranking[a_population.size() - count + n]] = std::move(arrivals[n]);
+
+            m_received += count;
+        }
+
+        // the islands
+        vector< evocosm<OrganismType> * > m_islands;
+
+        // migration paths
+        migration_topology m_topology;
+
+        // generations between migrations
+        size_t m_interval;
+
+        // organisms sent along each path
+        size_t m_emigrants;
+
+        // each island's test hook
+        vector<island_hook *> m_hooks;
+
+        // channels between islands, indexed by [from * islands + to]
+        vector< migration_channel<OrganismType> * > m_channels;
+
+        // generations run by each island
+        vector<size_t> m_generations;
+
+        // migration counters
+        std::atomic<size_t> m_sent;
+        std::atomic<size_t> m_received;
+        std::atomic<size_t> m_dropped;
+
+        // set when any island's run is complete
+        std::atomic<bool> m_stop;
+    };
+};
+
+#endif
@@ -89,8 +89,13 @@
 #if !defined(LIBEVOCOSM_LANDSCAPE_H)
 #define LIBEVOCOSM_LANDSCAPE_H
 
+// Standard C++ Library
+#include <algorithm>
+#include <vector>
+
 // libevocosm
 #include "organism.h"
+#include "fitness_cache.h"
 
 <<<<<<< 53bb9b38239f0b6fb908619d97286ae529277d0b
 =======
@@ -133,14 +138,20 @@ namespace libevocosm
 =======
             landscape(listener<OrganismType> & a_listener)
 >>>>>>> version 4.0.2
-              : m_listener(a_listener)
+              : m_listener(a_listener),
+                m_num_threads(1),
+                m_chunk_size(0),
+                m_fitness_cache(NULL)
             {
                 // nada
             }
 
             //! Copy constructor
             landscape(const landscape & a_source)
-              : m_listener(a_source.m_listener)
+              : m_listener(a_source.m_listener),
+                m_num_threads(a_source.m_num_threads),
+                m_chunk_size(a_source.m_chunk_size),
+                m_fitness_cache(a_source.m_fitness_cache)
             {
                 // nada
             }
@@ -151,6 +162,9 @@ namespace libevocosm
                 m_listener = a_source.m_listener;
 <<<<<<< 53bb9b38239f0b6fb908619d97286ae529277d0b
 =======
+                m_num_threads = a_source.m_num_threads;
+                m_chunk_size = a_source.m_chunk_size;
+                m_fitness_cache = a_source.m_fitness_cache;
                 return *this;
 >>>>>>> version 4.0.2
             }
@@ -192,21 +206,229 @@ namespace libevocosm
 =======
             virtual double test(vector<OrganismType> & a_population) const
             {
-                double result = 0.0;
+                if (m_fitness_cache != NULL)
+                    return test_cached(a_population);
 
-                for (int n = 0; n < (int)a_population.size(); ++n)
-                {
-                    a_population[n].fitness = test(a_population[n]);
-                    result += a_population[n].fitness;
-                }
+                test_organisms(a_population, NULL, a_population.size());
 
                 // return average fitness
                 return 0.0; // result / (double)a_population.size();
             }
 
+            //! Get the number of evaluation threads
+            /*!
+                Returns the number of threads used by the default population test.
+                \return Number of threads; zero means the OpenMP default
+            */
+            size_t get_num_threads() const
+            {
+                return m_num_threads;
+            }
+
+            //! Set the number of evaluation threads
+            /*!
+                Sets the number of threads used by the default population test.
+                When more than one thread is used, test(OrganismType &) is
+                called concurrently for different organisms, and must therefore
+                be safe to run in parallel. The population is divided into chunks
+                of fixed size, and each chunk draws random numbers from its own
+                stream, so a landscape that draws from g_random gets the same
+                results however the chunks are scheduled. Without OpenMP, testing
+                is always serial and this value is ignored.
+                \param a_num_threads - Number of threads; zero selects the OpenMP default, one (the default) tests serially
+            */
+            void set_num_threads(size_t a_num_threads)
+            {
+                m_num_threads = a_num_threads;
+            }
+
+            //! Get the evaluation chunk size
+            /*!
+                Returns the number of organisms handed to a thread at a time.
+                \return Chunk size; zero means it is computed from the population size
+            */
+            size_t get_chunk_size() const
+            {
+                return m_chunk_size;
+            }
+
+            //! Set the evaluation chunk size
+            /*!
+                Sets the number of organisms handed to a thread at a time. Chunks
+                are assigned dynamically, so threads that finish early pick up
+                more work; smaller chunks balance better when test times vary.
+                Random numbers drawn during testing depend on the chunk size.
+                \param a_chunk_size - Chunk size; zero computes one from the population size
+            */
+            void set_chunk_size(size_t a_chunk_size)
+            {
+                m_chunk_size = a_chunk_size;
+            }
+
+            //! Get the fitness cache
+            /*!
+                Returns the cache used by the default population test.
+                \return The fitness cache; NULL if caching is disabled
+            */
+            fitness_cache<OrganismType> * get_fitness_cache() const
+            {
+                return m_fitness_cache;
+            }
+
+            //! Set the fitness cache
+            /*!
+                Sets a cache that allows the default population test to skip
+                organisms whose genes it has already tested -- unchanged survivors,
+                and children identical to other organisms. Only use a cache if
+                test(OrganismType &) is deterministic and sets nothing in an
+                organism but what test_result<OrganismType> stores.
+                \param a_fitness_cache - The cache, which must exist while the landscape uses it; NULL disables caching
+            */
+            void set_fitness_cache(fitness_cache<OrganismType> * a_fitness_cache)
+            {
+                m_fitness_cache = a_fitness_cache;
+            }
+
         protected:
+            //! Performs fitness testing through the fitness cache
+            /*!
+                Tests each organism whose genes are not in the fitness cache, and
+                only one of each set of organisms with identical genes. Lookups and
+                updates of the cache are serial; the tests themselves run in parallel
+                as they do for an uncached population.
+                \param a_population - A vector containing organisms to be tested by the landscape.
+                \return A fitness value for the population as a whole; application-defined.
+            */
+            double test_cached(vector<OrganismType> & a_population) const
+            {
+                size_t count = a_population.size();
+
+                typedef test_result<OrganismType> result;
+                typename result::type cached;
+
+                vector<uint64_t> keys(count);
+                vector<size_t> misses;
+                vector< std::pair<size_t,size_t> > duplicates;
+                std::unordered_map<uint64_t,size_t> pending;
+
+                misses.reserve(count);
+
+                // look up every organism, keeping the first of each new genome for testing
+                for (size_t n = 0; n < count; ++n)
+                {
+                    keys[n] = m_fitness_cache->hash(a_population[n]);
+
+                    if (m_fitness_cache->lookup(keys[n], cached))
+                    {
+                        result::restore(a_population[n], cached);
+                        continue;
+                    }
+
+                    std::pair<typename std::unordered_map<uint64_t,size_t>::iterator, bool> first = pending.insert(std::make_pair(keys[n], n));
+
+                    if (first.second)
+                        misses.push_back(n);
+                    else
+                        duplicates.push_back(std::make_pair(n, first.first->second));
+                }
+
+                // test the new genomes
+                test_organisms(a_population, &misses, misses.size());
+
+                // remember the results, and share them with duplicates
+                for (size_t n = 0; n < misses.size(); ++n)
+                    m_fitness_cache->insert(keys[misses[n]], result::store(a_population[misses[n]]));
+
+                for (size_t n = 0; n < duplicates.size(); ++n)
+                    result::restore(a_population[duplicates[n].first], result::store(a_population[duplicates[n].second]));
+
+                m_fitness_cache->count_lookups(count - misses.size(), misses.size());
+
+                return 0.0;
+            }
+
+            // tests a_count organisms: the first ones in the population, or
+            // those listed in a_indexes if it is not NULL
+            void test_organisms(vector<OrganismType> & a_population, const vector<size_t> * a_indexes, size_t a_count) const
+            {
+                int count = (int)a_count;
+
+              #if defined(_OPENMP)
+                int threads = get_test_threads();
+
+                if (threads > 1)
+                {
+                    int chunk  = get_test_chunk(count, threads);
+                    int chunks = (count + chunk - 1) / chunk;
+
+                    // each chunk's stream is drawn from the caller's, so it depends
+                    // on the seed and on the chunk, not on the thread that tests it
+                    uint64_t first_stream = 0;
+
+                    for (int n = 0; n < 4; ++n)
+                        first_stream = (first_stream << 16) | (uint64_t)g_random.get_index(0x10000);
+
+                    #pragma omp parallel for schedule(dynamic,1) num_threads(threads)
+                    for (int c = 0; c < chunks; ++c)
+                    {
+                        stream_scope stream(first_stream + (uint64_t)c);
+                        int last = std::min(count, (c + 1) * chunk);
+
+                        for (int n = c * chunk; n < last; ++n)
+                        {
+                            OrganismType & org = a_population[(a_indexes != NULL) ? (*a_indexes)[n] : (size_t)n];
+                            org.fitness = test(org);
+                        }
+                    }
+
+                    return;
+                }
+              #endif
+
+                for (int n = 0; n < count; ++n)
+                {
+                    OrganismType & org = a_population[(a_indexes != NULL) ? (*a_indexes)[n] : (size_t)n];
+                    org.fitness = test(org);
+                }
+            }
+
+          #if defined(_OPENMP)
+            // number of threads for testing a population
+            int get_test_threads() const
+            {
+                return (m_num_threads > 0) ? (int)m_num_threads : omp_get_max_threads();
+            }
+
+            // number of organisms handed to a thread at a time
+            int get_test_chunk(int a_count, int a_threads) const
+            {
+                int chunk = (int)m_chunk_size;
+
+                // by default, hand out about sixteen chunks per thread so that
+                // expensive organisms don't leave the other threads idle
+                if (chunk < 1)
+                {
+                    chunk = a_count / (a_threads * 16);
+
+                    if (chunk < 1)
+                        chunk = 1;
+                }
+
+                return chunk;
+            }
+          #endif
+
             //! The listener for landscape events
             listener<OrganismType> & m_listener;
+
+            //! Number of threads used to test a population
+            size_t m_num_threads;
+
+            //! Number of organisms assigned to a thread at a time
+            size_t m_chunk_size;
+
+            //! Remembers fitness of tested genes; may be NULL
+            fitness_cache<OrganismType> * m_fitness_cache;
 >>>>>>> version 4.0.2
     };
 };
@@ -73,6 +73,9 @@
 #undef min
 #endif
 
+// libevocosm
+#include "generation_context.h"
+
 <<<<<<< e7caf0e4b99c29c75c9f17818cced7ecdcc9b5c0
 <<<<<<< 53bb9b38239f0b6fb908619d97286ae529277d0b
 using std::vector;
@@ -87,6 +90,87 @@ namespace libevocosm
 {
     template<typename T> class population;
 
+    //! Time spent in each phase of a generation
+    /*!
+        An evocosm with timing enabled measures each phase of a generation with a
+        steady, high-resolution clock, and reports the results to its listener.
+        All times are in seconds. Phases skipped in the final generation (every
+        phase after analysis) are zero. The total covers the whole generation,
+        and differs from the sum of the phases only by the cost of timing itself.
+    */
+    struct generation_timing
+    {
+        //! Fitness testing by the landscape
+        double test;
+
+        //! Analysis of test results
+        double analyze;
+
+        //! Fitness scaling
+        double scale;
+
+        //! Selection of survivors
+        double select;
+
+        //! Breeding of children
+        double breed;
+
+        //! Mutation of children
+        double mutate;
+
+        //! Assembly of the next generation
+        double replace;
+
+        //! Time given up to other work between phases
+        double yield;
+
+        //! Listener events
+        double listen;
+
+        //! The entire generation
+        double total;
+
+        //! Constructor
+        /*!
+            Creates a record with all times zero.
+        */
+        generation_timing()
+          : test(0.0),
+            analyze(0.0),
+            scale(0.0),
+            select(0.0),
+            breed(0.0),
+            mutate(0.0),
+            replace(0.0),
+            yield(0.0),
+            listen(0.0),
+            total(0.0)
+        {
+            // nada
+        }
+
+        //! Accumulation operator
+        /*!
+            Adds the times in another record to this one.
+            \param a_source - The times to add
+            \return A reference to this record
+        */
+        generation_timing & operator += (const generation_timing & a_source)
+        {
+            test    += a_source.test;
+            analyze += a_source.analyze;
+            scale   += a_source.scale;
+            select  += a_source.select;
+            breed   += a_source.breed;
+            mutate  += a_source.mutate;
+            replace += a_source.replace;
+            yield   += a_source.yield;
+            listen  += a_source.listen;
+            total   += a_source.total;
+            return *this;
+        }
+    };
+
     //! An abstract interface defining a listener
     /*!
         Evocosm reports its activities through a listener object derived from this abstract
@@ -113,6 +197,18 @@ namespace libevocosm
             */
             virtual void ping_generation_end(const vector<OrganismType> & a_population, size_t a_iteration) = 0;
 
+            //! Ping that a generation ends, with shared statistics
+            /*!
+                The evocosm calls this form, which lets a listener use the generation's
+                shared statistics rather than computing its own. By default, it calls
+                the form above.
+                \param a_context Population, iteration, and statistics for the generation
+            */
+            virtual void ping_generation_end(generation_context<OrganismType> & a_context)
+            {
+                ping_generation_end(a_context.get_population(), a_context.get_iteration());
+            }
+
             //! Ping that a test run begins
             /*!
                 Ping that fitness testing of an organism begins.
@@ -154,6 +250,20 @@ namespace libevocosm
                 rest on the seventh day.
             */
             virtual void run_complete(const vector<OrganismType> & a_population) = 0;
+
+            //! Ping with the time spent in a generation
+            /*!
+                Invoked at the end of each generation when the evocosm has timing
+                enabled. Unlike the other events, this one is ignored by default,
+                so that existing listeners need not implement it.
+                \param a_timing Time spent in each phase of this generation
+                \param a_totals Time spent in each phase of all timed generations, including this one
+                \param a_iteration One-based number of the generation timed
+            */
+            virtual void ping_generation_timing(const generation_timing & a_timing, const generation_timing & a_totals, size_t a_iteration)
+            {
+                // nada
+            }
     };
 
     //! An listener implementation that ignores all events
@@ -176,9 +176,7 @@ namespace libevocosm
                             size_t org2 = globals::g_random.get_rand_index(a_populations[trader].size());
     
                             // exchange organisms
-                            OrganismType temp = a_populations[p][org1];
-                            a_populations[p][org1] = a_populations[trader][org2];
-                            a_populations[trader][org2] = temp;
+                            std::swap(a_populations[p][org1], a_populations[trader][org2]);
 
                             // increment counts
                             ++move_count[p];
@@ -91,6 +91,7 @@
 
 // Standard C++ Library
 #include <cstddef>
+#include <utility>
 
 // libevocosm
 #include "evocommon.h"
@@ -124,6 +125,9 @@ namespace libevocosm
     public:
 =======
     public:
+        //! The type of this organism's genes
+        typedef Genotype genotype_t;
+
         /*!
             Fitness is assigned by the landscape in which an organism is tested.
             A scaler object may alter fitness values after testing; a selector
@@ -209,6 +213,31 @@ namespace libevocosm
             // nada
         }
 
+        //! Move constructor
+        /*!
+            Creates a new object that takes over the genes of an existing one,
+            leaving the source with empty (moved-from) genes.
+            \param a_source - The source object
+        */
+        organism(organism && a_source)
+            : fitness(a_source.fitness),
+              genes(std::move(a_source.genes))
+        {
+            // nada
+        }
+
+        //! Value constructor (move)
+        /*!
+            Creates a new organism that takes over a set of genes.
+            \param a_genes - Gene value for the new organism
+        */
+        organism(Genotype && a_genes)
+            : fitness(0.0),
+              genes(std::move(a_genes))
+        {
+            // nada
+        }
+
         //! Virtual destructor
         /*!
             A virtual destructor. By default, it does nothing; this is
@@ -239,6 +268,19 @@ namespace libevocosm
             return *this;
         }
 
+        //! Move assignment operator
+        /*!
+            Gives an existing object the state of another, taking over its genes.
+            \param a_source - The source object
+            \return A reference to <i>this</i>
+        */
+        organism & operator = (organism && a_source)
+        {
+            fitness = a_source.fitness;
+            genes   = std::move(a_source.genes);
+            return *this;
+        }
+
         //! assignment operator
         /*!
             Assigns an existing object the state of another.
@@ -355,6 +397,111 @@ namespace libevocosm
         }
     };
 
+    //! A compact, non-polymorphic organism
+    /*!
+        A compact_organism has the same public members and constructors as an
+        organism, and may be used wherever the library expects one, but it has no
+        virtual functions. Without a vtable pointer it is only as large as its
+        fitness and genes, its comparison is inlined by algorithms such as
+        std::sort, and it is trivially copyable whenever its genotype is; a
+        population of fixed-size genomes (an array of doubles, say) can then be
+        copied in bulk and stored densely.
+
+        A derived class customizes a compact_organism statically, by hiding
+        reset or operator < with functions of its own; they are not virtual,
+        so a derived object must never be used or destroyed through a pointer
+        to compact_organism.
+        \param Genotype - The type of genes for this organism class
+    */
+    template <typename Genotype>
+    class compact_organism
+    {
+    public:
+        //! The type of this organism's genes
+        typedef Genotype genotype_t;
+
+        //! Fitness, as for organism
+        double fitness;
+
+        //! Genes, as for organism
+        Genotype genes;
+
+        //! Creation constructor
+        /*!
+            Creates a new organism, with default genes and zero fitness.
+        */
+        compact_organism()
+            : fitness(0.0),
+              genes()
+        {
+            // nada
+        }
+
+        //! Value constructor
+        /*!
+            Creates a new organism with specific genes.
+            \param a_genes - Gene value for the new organism
+        */
+        compact_organism(const Genotype & a_genes)
+            : fitness(0.0),
+              genes(a_genes)
+        {
+            // nada
+        }
+
+        //! Value constructor (move)
+        /*!
+            Creates a new organism that takes over a set of genes.
+            \param a_genes - Gene value for the new organism
+        */
+        compact_organism(Genotype && a_genes)
+            : fitness(0.0),
+              genes(std::move(a_genes))
+        {
+            // nada
+        }
+
+        // copying, moving and destruction are left to the compiler, so that they
+        // stay trivial when the genotype's are
+        compact_organism(const compact_organism & a_source) = default;
+        compact_organism(compact_organism && a_source) = default;
+        compact_organism & operator = (const compact_organism & a_source) = default;
+        compact_organism & operator = (compact_organism && a_source) = default;
+        ~compact_organism() = default;
+
+        //! assignment operator
+        /*!
+            Gives an existing object new genes and zero fitness.
+            \param a_genes - The source object
+            \return A reference to <i>this</i>
+        */
+        compact_organism & operator = (const Genotype & a_genes)
+        {
+            fitness = 0.0;
+            genes   = a_genes;
+            return *this;
+        }
+
+        //! Comparison operator for algorithms
+        /*!
+            Orders organisms from most to least fit, as organism does.
+            \param a_right - Right hand argument for less than operator
+        */
+        bool operator < (const compact_organism & a_right) const
+        {
+            return (fitness > a_right.fitness);
+        }
+
+        //! Resets an object to it's initial state
+        /*!
+            Sets the fitness to zero.
+        */
+        void reset()
+        {
+            fitness = 0.0;
+        }
+    };
+
 };
 
 #endif
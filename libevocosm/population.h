@@ -0,0 +1,343 @@
+/*
+    Evocosm is a C++ framework for implementing evolutionary algorithms.
+
+    Copyright 2011 Scott Robert Ladd. All rights reserved.
+
+    Evocosm is user-supported open source software. Its continued development is dependent
+    on financial support from the community. You can provide funding by visiting the Evocosm
+    website at:
+
+        http://www.coyotegulch.com
+
+    You may license Evocosm in one of two fashions:
+
+    1) Simplified BSD License (FreeBSD License)
+
+    Redistribution and use in source and binary forms, with or without modification, are
+    permitted provided that the following conditions are met:
+
+    1.  Redistributions of source code must retain the above copyright notice, this list of
+        conditions and the following disclaimer.
+
+    2.  Redistributions in binary form must reproduce the above copyright notice, this list
+        of conditions and the following disclaimer in the documentation and/or other materials
+        provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY SCOTT ROBERT LADD ``AS IS'' AND ANY EXPRESS OR IMPLIED
+    WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+    FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SCOTT ROBERT LADD OR
+    CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+    ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+    The views and conclusions contained in the software and documentation are those of the
+    authors and should not be interpreted as representing official policies, either expressed
+    or implied, of Scott Robert Ladd.
+
+    2) Closed-Source Proprietary License
+
+    If your project is a closed-source or proprietary project, the Simplified BSD License may
+    not be appropriate or desirable. In such cases, contact the Evocosm copyright holder to
+    arrange your purchase of an appropriate license.
+
+    The author can be contacted at:
+
+          scott.ladd@coyotegulch.com
+          scott.ladd@gmail.com
+          http:www.coyotegulch.com
+*/
+
+#if !defined(LIBEVOCOSM_POPULATION_H)
+#define LIBEVOCOSM_POPULATION_H
+
+// Standard C++ Library
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// libevocosm
+#include "organism.h"
+
+namespace libevocosm
+{
+    using std::vector;
+
+    //! Reads fitness from a population or from an array of fitness values
+    /*!
+        Statistics, scalers and selectors that only look at fitness use these
+        functions to work on a vector of organisms and on the fitness array of a
+        soa_population with the same code.
+    */
+    class fitness_access
+    {
+    public:
+        //! Get the fitness of an organism
+        template <class OrganismType>
+        static double get(const vector<OrganismType> & a_population, size_t a_index)
+        {
+            return a_population[a_index].fitness;
+        }
+
+        //! Get a fitness value
+        static double get(const vector<double> & a_fitness, size_t a_index)
+        {
+            return a_fitness[a_index];
+        }
+
+        //! Get the fitness of an organism, for changing
+        template <class OrganismType>
+        static double & at(vector<OrganismType> & a_population, size_t a_index)
+        {
+            return a_population[a_index].fitness;
+        }
+
+        //! Get a fitness value, for changing
+        static double & at(vector<double> & a_fitness, size_t a_index)
+        {
+            return a_fitness[a_index];
+        }
+    };
+
+    //! A population stored as a structure of arrays
+    /*!
+        A soa_population keeps the fitness of its organisms in one contiguous
+        array, and their genes in another, rather than in a vector of organisms.
+        Operations that only look at fitness -- statistics, scaling, selection
+        -- then read a dense array of doubles instead of striding over genes and
+        vtable pointers. With a fixed-size genotype, such as an array of doubles,
+        the genes are contiguous as well.
+        <p>
+        An organism's index never changes while it is in the population. The
+        fitness array can be handed to fitness_stats, to the array forms of
+        scaler::scale_fitness and selector::select_survivors, and to the kernels
+        in scaling_tools. An evocosm uses the same array forms for each
+        generation when evocosm::set_fitness_apart is set.
+        <p>
+        The adapter functions convert to and from a vector of organisms, so code
+        written for vectors still works; only fitness and genes are kept, so
+        any other members of an organism class are default-initialized when it
+        is rebuilt, as with organism_serializer. The organism type must be
+        constructible from an rvalue of its genotype.
+        \param OrganismType - The type of organism whose fitness and genes are stored
+    */
+    template <class OrganismType>
+    class soa_population
+    {
+    public:
+        //! The type of the stored genes
+        typedef typename OrganismType::genotype_t genotype_t;
+
+        //! Creation constructor
+        /*!
+            Creates an empty population.
+        */
+        soa_population()
+          : m_fitness(),
+            m_genes()
+        {
+            // nada
+        }
+
+        //! Conversion constructor
+        /*!
+            Creates a population holding copies of the fitness and genes of a
+            vector of organisms.
+            \param a_organisms - The organisms
+        */
+        explicit soa_population(const vector<OrganismType> & a_organisms)
+          : m_fitness(),
+            m_genes()
+        {
+            append(a_organisms);
+        }
+
+        //! Get the number of organisms
+        size_t size() const
+        {
+            return m_fitness.size();
+        }
+
+        //! Is the population empty?
+        bool empty() const
+        {
+            return m_fitness.empty();
+        }
+
+        //! Reserve space
+        /*!
+            \param a_size - Number of organisms to make room for
+        */
+        void reserve(size_t a_size)
+        {
+            m_fitness.reserve(a_size);
+            m_genes.reserve(a_size);
+        }
+
+        //! Remove every organism
+        void clear()
+        {
+            m_fitness.clear();
+            m_genes.clear();
+        }
+
+        //! Get an organism's fitness
+        double & fitness(size_t a_index)
+        {
+            return m_fitness[a_index];
+        }
+
+        //! Get an organism's fitness (read-only)
+        double fitness(size_t a_index) const
+        {
+            return m_fitness[a_index];
+        }
+
+        //! Get an organism's genes
+        genotype_t & genes(size_t a_index)
+        {
+            return m_genes[a_index];
+        }
+
+        //! Get an organism's genes (read-only)
+        const genotype_t & genes(size_t a_index) const
+        {
+            return m_genes[a_index];
+        }
+
+        //! Get the fitness array
+        /*!
+            The array may be changed in place, but not resized.
+            \return Fitness of every organism, by index
+        */
+        vector<double> & get_fitness()
+        {
+            return m_fitness;
+        }
+
+        //! Get the fitness array (read-only)
+        const vector<double> & get_fitness() const
+        {
+            return m_fitness;
+        }
+
+        //! Get the gene array (read-only)
+        const vector<genotype_t> & get_genes() const
+        {
+            return m_genes;
+        }
+
+        //! Add an organism
+        /*!
+            \param a_organism - Organism whose fitness and genes are copied
+        */
+        void push_back(const OrganismType & a_organism)
+        {
+            m_fitness.push_back(a_organism.fitness);
+            m_genes.push_back(a_organism.genes);
+        }
+
+        //! Add an organism, taking over its genes
+        /*!
+            \param a_organism - Organism whose genes are moved into the population
+        */
+        void push_back(OrganismType && a_organism)
+        {
+            m_fitness.push_back(a_organism.fitness);
+            m_genes.push_back(std::move(a_organism.genes));
+        }
+
+        //! Add copies of a vector of organisms
+        /*!
+            \param a_organisms - The organisms
+        */
+        void append(const vector<OrganismType> & a_organisms)
+        {
+            reserve(size() + a_organisms.size());
+
+            for (size_t n = 0; n < a_organisms.size(); ++n)
+                push_back(a_organisms[n]);
+        }
+
+        //! Replace the contents with a vector of organisms
+        /*!
+            Takes over the genes of a vector of organisms, leaving the vector empty.
+            \param a_organisms - The organisms
+        */
+        void assign(vector<OrganismType> && a_organisms)
+        {
+            clear();
+            reserve(a_organisms.size());
+
+            for (size_t n = 0; n < a_organisms.size(); ++n)
+                push_back(std::move(a_organisms[n]));
+
+            a_organisms.clear();
+        }
+
+        //! Build an organism
+        /*!
+            \param a_index - Index of the organism
+            \return An organism with copies of the stored fitness and genes
+        */
+        OrganismType get_organism(size_t a_index) const
+        {
+            genotype_t copy(m_genes[a_index]);
+            OrganismType result(std::move(copy));
+            result.fitness = m_fitness[a_index];
+            return result;
+        }
+
+        //! Move the population into a vector of organisms
+        /*!
+            Appends the organisms, in index order, to a vector, moving their
+            genes; the population is left empty.
+            \param a_organisms - Vector to which organisms are appended
+        */
+        void extract(vector<OrganismType> & a_organisms)
+        {
+            a_organisms.reserve(a_organisms.size() + size());
+
+            for (size_t n = 0; n < size(); ++n)
+            {
+                a_organisms.push_back(OrganismType(std::move(m_genes[n])));
+                a_organisms.back().fitness = m_fitness[n];
+            }
+
+            clear();
+        }
+
+        //! Copy fitness from a vector of organisms
+        /*!
+            Refreshes the fitness array from organisms that correspond, index by
+            index, to those in the population, such as those it was built from.
+            \param a_organisms - The organisms; there must be at least size() of them
+        */
+        void load_fitness(const vector<OrganismType> & a_organisms)
+        {
+            for (size_t n = 0; n < m_fitness.size(); ++n)
+                m_fitness[n] = a_organisms[n].fitness;
+        }
+
+        //! Copy fitness to a vector of organisms
+        /*!
+            \param a_organisms - The corresponding organisms; there must be at least size() of them
+        */
+        void store_fitness(vector<OrganismType> & a_organisms) const
+        {
+            for (size_t n = 0; n < m_fitness.size(); ++n)
+                a_organisms[n].fitness = m_fitness[n];
+        }
+
+    private:
+        // fitness, by index
+        vector<double> m_fitness;
+
+        // genes, by index
+        vector<genotype_t> m_genes;
+    };
+};
+
+#endif
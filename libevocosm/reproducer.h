@@ -89,6 +89,9 @@
 #if !defined(LIBEVOCOSM_REPRODUCER_H)
 #define LIBEVOCOSM_REPRODUCER_H
 
+// Standard C++ Library
+#include <stdexcept>
+
 // libevocosm
 #include "organism.h"
 
@@ -125,11 +128,137 @@ namespace libevocosm
         /*!
             A population provides genetic material for the creation of new children (who,
             will, like real children, forget where they left their shoes).
+            <p>
+            By default, this function is an adapter that collects the children
+            made by the appending form of breed. A reproducer must override at
+            least one of the two.
             \param a_population - A population of organisms
             \param a_limit - The maximum number of children the generate
             \return A vector containing new "child" organisms
         */
-        virtual vector<OrganismType> breed(const vector<OrganismType> & a_population, size_t a_limit) = 0;
+        virtual vector<OrganismType> breed(const vector<OrganismType> & a_population, size_t a_limit)
+        {
+            vector<OrganismType> children;
+            children.reserve(a_limit);
+
+            if (!breed(a_population, a_limit, children))
+                throw std::runtime_error("reproducer does not implement breed");
+
+            return children;
+        }
+
+        //! Creates children in a caller-provided vector
+        /*!
+            Appends children to the end of a vector, leaving its existing elements
+            alone. The caller can reuse the vector from one generation to the next,
+            avoiding both the allocation of a new vector and the copying of
+            children out of it. The <i>a_children</i> vector must not be
+            <i>a_population</i>.
+            <p>
+            The default implementation does nothing and returns <i>false</i>,
+            telling the caller to use the vector-returning form of breed instead.
+            \param a_population - A population of organisms
+            \param a_limit - The maximum number of children the generate
+            \param a_children - Vector to which children are appended
+            \return <i>true</i> if children were appended; <i>false</i> if this form is not implemented
+        */
+        virtual bool breed(const vector<OrganismType> & a_population, size_t a_limit, vector<OrganismType> & a_children)
+        {
+            return false;
+        }
+    };
+
+    //! Creates children from parents chosen by tournament
+    /*!
+        A tournament reproducer chooses each parent as the winner of a tournament
+        among organisms drawn at random, with replacement. It needs no roulette
+        wheel and no scaled fitness, only comparisons, so it pairs naturally with
+        a null_scaler. A derived class supplies mate, which creates a child from a
+        first parent and may call select_parent for others.
+        \param OrganismType - The type of organism
+    */
+    template <class OrganismType>
+    class tournament_reproducer : public reproducer<OrganismType>
+    {
+    public:
+        //! Constructor
+        /*!
+            Creates a new tournament reproducer.
+            \param a_tournament_size - Number of contestants in each tournament; at least one
+        */
+        tournament_reproducer(size_t a_tournament_size = 2)
+            : m_tournament_size(a_tournament_size > 0 ? a_tournament_size : 1)
+        {
+            // nada
+        }
+
+        //! Get the number of contestants in each tournament
+        size_t get_tournament_size() const
+        {
+            return m_tournament_size;
+        }
+
+        //! Creates children in a caller-provided vector
+        /*!
+            Appends a_limit children, each made by mate from a parent chosen by
+            tournament; an empty population produces no children.
+            \param a_population - A population of organisms
+            \param a_limit - The number of children to generate
+            \param a_children - Vector to which children are appended
+            \return <i>true</i>
+        */
+        virtual bool breed(const vector<OrganismType> & a_population, size_t a_limit, vector<OrganismType> & a_children)
+        {
+            if (a_population.empty())
+                return true;
+
+            a_children.reserve(a_children.size() + a_limit);
+
+            for (size_t n = 0; n < a_limit; ++n)
+                a_children.push_back(mate(a_population, select_parent(a_population)));
+
+            return true;
+        }
+
+        // the vector-returning form is the base class adapter
+        using reproducer<OrganismType>::breed;
+
+    protected:
+        //! Choose a parent by tournament
+        /*!
+            The organism with the highest fitness among those drawn wins; the
+            first one drawn wins a tie.
+            \param a_population - A population of organisms; must not be empty
+            \return The index of the winner
+        */
+        size_t select_parent(const vector<OrganismType> & a_population) const
+        {
+            size_t winner = globals::g_random.get_index(a_population.size());
+
+            for (size_t t = 1; t < m_tournament_size; ++t)
+            {
+                size_t contestant = globals::g_random.get_index(a_population.size());
+
+                if (a_population[contestant].fitness > a_population[winner].fitness)
+                    winner = contestant;
+            }
+
+            return winner;
+        }
+
+        //! Create a child
+        /*!
+            Creates one child from a parent, choosing any other parents it
+            needs with select_parent.
+            \param a_population - A population of organisms
+            \param a_parent - Index of the first parent
+            \return A new child
+        */
+        virtual OrganismType mate(const vector<OrganismType> & a_population, size_t a_parent) = 0;
+
+    private:
+        // contestants per tournament
+        size_t m_tournament_size;
     };
 };
 
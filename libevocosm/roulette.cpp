@@ -96,6 +96,7 @@ using namespace libcoyotl;
           http:www.coyotegulch.com
 */
 
+#include <algorithm>
 #include <stdexcept>
 #include <cstring>
 
@@ -105,6 +106,58 @@ using namespace libcoyotl;
 #include "roulette.h"
 using namespace libevocosm;
 
+namespace
+{
+    // stochastic universal sampling over an array of weights
+    void universal_sample(prng_streams & a_random,
+                          const double * a_weights,
+                          size_t a_size,
+                          size_t a_count,
+                          vector<size_t> & a_indexes,
+                          bool a_shuffle)
+    {
+        a_indexes.clear();
+
+        if (a_count == 0)
+            return;
+
+        a_indexes.reserve(a_count);
+
+        // sum the weights here, rather than trusting a running total
+        double total = 0.0;
+
+        for (size_t i = 0; i < a_size; ++i)
+            total += a_weights[i];
+
+        // one spin places all the pointers
+        double spacing = total / double(a_count);
+        double start   = a_random.get_real() * spacing;
+
+        size_t i = 0;
+        double edge = a_weights[0];
+
+        for (size_t n = 0; n < a_count; ++n)
+        {
+            double pointer = start + double(n) * spacing;
+
+            while ((pointer >= edge) && (i + 1 < a_size))
+            {
+                ++i;
+                edge += a_weights[i];
+            }
+
+            a_indexes.push_back(i);
+        }
+
+        // Fisher-Yates
+        if (a_shuffle)
+        {
+            for (size_t n = a_count - 1; n > 0; --n)
+                std::swap(a_indexes[n], a_indexes[a_random.get_index(n + 1)]);
+        }
+    }
+}
+
 // creation constructor
 roulette_wheel::roulette_wheel(const vector<double> & a_weights, double a_min_weight, double a_max_weight)
   : m_size(a_weights.size()),
@@ -196,11 +249,25 @@ roulette_wheel::roulette_wheel(const roulette_wheel & a_source)
     memcpy(m_weights,a_source.m_weights,sizeof(double) * m_size);
 }
 
+// move constructor
+roulette_wheel::roulette_wheel(roulette_wheel && a_source)
+  : m_size(a_source.m_size),
+    m_weights(a_source.m_weights),
+    m_total_weight(a_source.m_total_weight),
+    m_min_weight(a_source.m_min_weight),
+    m_max_weight(a_source.m_max_weight)
+{
+    a_source.m_size         = 0;
+    a_source.m_weights      = NULL;
+    a_source.m_total_weight = 0.0;
+}
+
 // assignment operator
 roulette_wheel & roulette_wheel::operator = (const roulette_wheel & a_source)
 {
     if (this != &a_source)
     {
+        delete [] m_weights;
         m_size         = a_source.m_size;
         m_weights      = new double[m_size];
         memcpy(m_weights,a_source.m_weights,sizeof(double) * m_size);
@@ -216,6 +283,26 @@ roulette_wheel & roulette_wheel::operator = (const roulette_wheel & a_source)
     return *this;
 }
 
+// move assignment operator
+roulette_wheel & roulette_wheel::operator = (roulette_wheel && a_source)
+{
+    if (this != &a_source)
+    {
+        delete [] m_weights;
+        m_size         = a_source.m_size;
+        m_weights      = a_source.m_weights;
+        m_total_weight = a_source.m_total_weight;
+        m_min_weight   = a_source.m_min_weight;
+        m_max_weight   = a_source.m_max_weight;
+
+        a_source.m_size         = 0;
+        a_source.m_weights      = NULL;
+        a_source.m_total_weight = 0.0;
+    }
+
+    return *this;
+}
+
 // destructor
 roulette_wheel::~roulette_wheel()
 {
@@ -289,3 +376,237 @@ size_t roulette_wheel::get_index() const
     return i;
 }
 
+// select many indexes at once
+void roulette_wheel::sample(size_t a_count, vector<size_t> & a_indexes, bool a_shuffle) const
+{
+    universal_sample(g_random,m_weights,m_size,a_count,a_indexes,a_shuffle);
+}
+
+// create an alias table from weights
+alias_roulette_wheel::alias_roulette_wheel(const vector<double> & a_weights, double a_min_weight, double a_max_weight)
+  : m_size(a_weights.size()),
+    m_weights(a_weights.size()),
+    m_probability(a_weights.size()),
+    m_alias(a_weights.size())
+{
+    double min_weight = fabs(a_min_weight);
+    double max_weight = fabs(a_max_weight);
+
+    validate_less(min_weight,max_weight,"Minimum weight must be less than maximum");
+    validate_not(m_size,size_t(0),"Roulette wheel can not have zero size");
+
+    double total_weight = 0.0;
+
+    for (size_t i = 0; i < m_size; ++i)
+    {
+        double weight = fabs(a_weights[i]);
+
+        if (weight < min_weight)
+            weight = min_weight;
+        else
+            if (weight > max_weight)
+                weight = max_weight;
+
+        m_weights[i]  = weight;
+        total_weight += weight;
+    }
+
+    validate_greater(total_weight,0.0,"Roulette wheel must have a total weight > zero");
+
+    // scale weights so the average column holds exactly 1.0
+    double scale = double(m_size) / total_weight;
+
+    // columns holding less than 1.0 are topped up from those holding more; one
+    // work array holds the short columns at its front and the tall at its back
+    vector<size_t> work(m_size);
+    size_t small_end   = 0;
+    size_t large_begin = m_size;
+
+    for (size_t i = 0; i < m_size; ++i)
+    {
+        m_probability[i] = m_weights[i] * scale;
+        m_alias[i]       = i;
+
+        if (m_probability[i] < 1.0)
+            work[small_end++] = i;
+        else
+            work[--large_begin] = i;
+    }
+
+    while ((small_end > 0) && (large_begin < m_size))
+    {
+        size_t less = work[--small_end];
+        size_t more = work[large_begin];
+
+        // the rest of the short column selects the tall one
+        m_alias[less] = more;
+        m_probability[more] -= 1.0 - m_probability[less];
+
+        if (m_probability[more] < 1.0)
+        {
+            ++large_begin;
+            work[small_end++] = more;
+        }
+    }
+
+    // anything left is full, give or take rounding error
+    for (size_t i = 0; i < small_end; ++i)
+        m_probability[work[i]] = 1.0;
+
+    for (size_t i = large_begin; i < m_size; ++i)
+        m_probability[work[i]] = 1.0;
+}
+
+// interrogator
+double alias_roulette_wheel::get_weight(size_t a_index) const
+{
+    validate_less(a_index,m_size,"invalid roulette wheel index");
+    return m_weights[a_index];
+}
+
+// select many indexes at once
+void alias_roulette_wheel::sample(size_t a_count, vector<size_t> & a_indexes, bool a_shuffle) const
+{
+    universal_sample(g_random,&m_weights[0],m_size,a_count,a_indexes,a_shuffle);
+}
+
+// create a fenwick wheel from a vector
+fenwick_roulette_wheel::fenwick_roulette_wheel(const vector<double> & a_weights, double a_min_weight, double a_max_weight)
+  : m_size(a_weights.size()),
+    m_weights(a_weights.size()),
+    m_tree(a_weights.size() + 1),
+    m_total_weight(0.0),
+    m_min_weight(fabs(a_min_weight)),
+    m_max_weight(fabs(a_max_weight)),
+    m_updates(0)
+{
+    validate_less(m_min_weight,m_max_weight,"Minimum weight must be less than maximum");
+    validate_not(m_size,size_t(0),"Roulette wheel can not have zero size");
+
+    init(&a_weights[0]);
+}
+
+// create a fenwick wheel from a C array
+fenwick_roulette_wheel::fenwick_roulette_wheel(const double * a_weights, size_t a_size, double a_min_weight, double a_max_weight)
+  : m_size(a_size),
+    m_weights(a_size),
+    m_tree(a_size + 1),
+    m_total_weight(0.0),
+    m_min_weight(fabs(a_min_weight)),
+    m_max_weight(fabs(a_max_weight)),
+    m_updates(0)
+{
+    validate_not(m_size,size_t(0),"Roulette wheel can not have zero size");
+    validate_less(m_min_weight,m_max_weight,"Minimum weight must be less than maximum");
+
+    init(a_weights);
+}
+
+// clamp weights and build the tree
+void fenwick_roulette_wheel::init(const double * a_weights)
+{
+    for (size_t i = 0; i < m_size; ++i)
+    {
+        double weight = fabs(a_weights[i]);
+
+        if (weight < m_min_weight)
+            weight = m_min_weight;
+        else
+            if (weight > m_max_weight)
+                weight = m_max_weight;
+
+        m_weights[i] = weight;
+    }
+
+    rebuild();
+
+    validate_greater(m_total_weight,0.0,"Roulette wheel must have a total weight > zero");
+}
+
+// compute partial sums in linear time
+void fenwick_roulette_wheel::rebuild()
+{
+    m_total_weight = 0.0;
+
+    for (size_t i = 1; i <= m_size; ++i)
+    {
+        m_tree[i] = m_weights[i - 1];
+        m_total_weight += m_weights[i - 1];
+    }
+
+    for (size_t i = 1; i <= m_size; ++i)
+    {
+        size_t parent = i + (i & (~i + 1));
+
+        if (parent <= m_size)
+            m_tree[parent] += m_tree[i];
+    }
+
+    m_updates = 0;
+}
+
+// change the weight of an entry
+double fenwick_roulette_wheel::set_weight(size_t a_index, double a_weight)
+{
+    validate_less(a_index,m_size,"invalid roulette wheel index");
+
+    a_weight = fabs(a_weight);
+
+    if (a_weight < m_min_weight)
+        a_weight = m_min_weight;
+    else
+        if (a_weight > m_max_weight)
+            a_weight = m_max_weight;
+
+    double res = m_weights[a_index];
+    m_weights[a_index] = a_weight;
+
+    // updating partial sums by difference accumulates rounding error, so
+    // rebuild them once in a while; the cost is constant per update
+    if (++m_updates >= m_size)
+        rebuild();
+    else
+    {
+        double delta = a_weight - res;
+        m_total_weight += delta;
+
+        for (size_t i = a_index + 1; i <= m_size; i += (i & (~i + 1)))
+            m_tree[i] += delta;
+    }
+
+    return res;
+}
+
+// interrogator
+double fenwick_roulette_wheel::get_weight(size_t a_index) const
+{
+    validate_less(a_index,m_size,"invalid roulette wheel index");
+    return m_weights[a_index];
+}
+
+// retrieve a random index by descending the tree
+size_t fenwick_roulette_wheel::get_index() const
+{
+    double choice = g_random.get_real() * m_total_weight;
+
+    size_t step = 1;
+
+    while ((step << 1) <= m_size)
+        step <<= 1;
+
+    size_t i = 0;
+
+    for (; step > 0; step >>= 1)
+    {
+        size_t next = i + step;
+
+        if ((next <= m_size) && (choice >= m_tree[next]))
+        {
+            choice -= m_tree[next];
+            i = next;
+        }
+    }
+
+    // rounding can leave the ball just past the last slot
+    return (i < m_size) ? i : m_size - 1;
+}
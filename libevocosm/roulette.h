@@ -171,6 +171,14 @@ namespace libevocosm
         
 =======
 
+        //! Move constructor
+        /*!
+            Creates a new roulette_wheel that takes over the weights of an
+            existing one, leaving the source empty.
+            \param a_source - The source object
+        */
+        roulette_wheel(roulette_wheel && a_source);
+
 >>>>>>> version 4.0.2
         //! Assignment operator
         /*!
@@ -182,6 +190,13 @@ namespace libevocosm
         
 =======
 
+        //! Move assignment operator
+        /*!
+            Gives a roulette_wheel the weights of another, leaving the source empty.
+            \param a_source - The source object
+        */
+        roulette_wheel & operator = (roulette_wheel && a_source);
+
 >>>>>>> version 4.0.2
         //! Destructor
         /*!
@@ -240,6 +255,23 @@ namespace libevocosm
         
 =======
 
+        //! Select many indexes at once
+        /*!
+            Selects a number of indexes by stochastic universal sampling: the
+            wheel is spun once, and the selected slots lie under a_count evenly
+            spaced pointers. Each index is chosen in proportion to its weight,
+            as with get_index, but the number of times an index is chosen never
+            differs from its expected value by a whole selection or more. The
+            whole sample takes a single pass over the weights.
+            <p>
+            Sampled indexes come out in ascending order; shuffle them before
+            pairing them up as parents.
+            \param a_count - Number of indexes to select
+            \param a_indexes - Receives the selected indexes, replacing its contents
+            \param a_shuffle - Shuffle the selected indexes into random order
+        */
+        void sample(size_t a_count, vector<size_t> & a_indexes, bool a_shuffle = false) const;
+
 >>>>>>> version 4.0.2
     protected:
         //! Number of weights in this wheel
@@ -271,6 +303,198 @@ namespace libevocosm
         // internal copy function
         void copy(const roulette_wheel & a_source);
     };
+
+    //! A roulette wheel with constant-time selection
+    /*!
+        An alias_roulette_wheel selects indexes with the same probabilities as a
+        roulette_wheel built from the same weights, but in constant time rather
+        than time proportional to the number of weights. Construction builds
+        Walker's alias table with Vose's method, in linear time; each selection
+        then draws one random number, picks a column of the table, and returns
+        either that column's index or its alias.
+        <p>
+        The weights can not be changed once the wheel is built, making it a good
+        choice for selecting many parents from a population whose fitness is
+        fixed for the generation, such as in a reproducer's breed function.
+        Use a roulette_wheel when weights change between selections.
+    */
+    class alias_roulette_wheel : protected globals
+    {
+    public:
+        //! Creation constructor (from vector)
+        /*!
+            Creates a new alias_roulette_wheel based on a set of weights.
+            \param a_weights - A vector of weights defining the wheel
+            \param a_min_weight - Minimum possible weight value (defaults to epsilon for type)
+            \param a_max_weight - Maximum possible weight value (defaults to max for type)
+        */
+        alias_roulette_wheel(const vector<double> & a_weights,
+                             double a_min_weight = std::numeric_limits<double>::epsilon(),
+                             double a_max_weight = std::numeric_limits<double>::max());
+
+        //! Get size (number of weights)
+        /*!
+            Gets the number of weights indexed by the wheel.
+            \return The number of weights
+        */
+        size_t get_size() const
+        {
+            return m_size;
+        }
+
+        //! Get the weight for an index
+        /*!
+            Gets the weight assigned to a specific index, after clamping.
+            \param a_index Index for which weight should be returned
+            \return Weight for this index
+        */
+        double get_weight(size_t a_index) const;
+
+        //! Retrieve a random index
+        /*!
+            Returns a randomly-selected index value, where the chance of
+            selecting each index is proportional to its weight.
+            \return A random index value
+        */
+        size_t get_index() const
+        {
+            double column = g_random.get_real() * double(m_size);
+            size_t index  = size_t(column);
+
+            // guard against rounding up to m_size
+            if (index >= m_size)
+                index = m_size - 1;
+
+            return ((column - double(index)) < m_probability[index]) ? index : m_alias[index];
+        }
+
+        //! Select many indexes at once
+        /*!
+            Selects a number of indexes by stochastic universal sampling, as
+            roulette_wheel::sample does.
+            \param a_count - Number of indexes to select
+            \param a_indexes - Receives the selected indexes, replacing its contents
+            \param a_shuffle - Shuffle the selected indexes into random order
+        */
+        void sample(size_t a_count, vector<size_t> & a_indexes, bool a_shuffle = false) const;
+
+    protected:
+        //! Number of weights in this wheel
+        size_t m_size;
+
+        //! Weights, after clamping
+        vector<double> m_weights;
+
+        //! Chance of returning a column's own index rather than its alias
+        vector<double> m_probability;
+
+        //! Index returned when a column's own index is not chosen
+        vector<size_t> m_alias;
+    };
+
+    //! A roulette wheel with logarithmic-time selection and reweighting
+    /*!
+        A fenwick_roulette_wheel behaves like a roulette_wheel, including the
+        clamping of weights to a minimum and maximum, but keeps its weights in a
+        Fenwick (binary indexed) tree of partial sums. Both set_weight and
+        get_index take time proportional to the logarithm of the number of
+        weights, rather than the linear time roulette_wheel::get_index takes.
+        <p>
+        For a handful of weights the linear scan of a roulette_wheel is just as
+        fast; the tree pays off for wheels with dozens of entries or more, such
+        as the state transitions of a large fuzzy_machine.
+    */
+    class fenwick_roulette_wheel : protected globals
+    {
+    public:
+        //! Creation constructor (from vector)
+        /*!
+            Creates a new fenwick_roulette_wheel based on a set of weights.
+            \param a_weights - A vector of weights defining the wheel
+            \param a_min_weight - Minimum possible weight value (defaults to epsilon for type)
+            \param a_max_weight - Maximum possible weight value (defaults to max for type)
+        */
+        fenwick_roulette_wheel(const vector<double> & a_weights,
+                               double a_min_weight = std::numeric_limits<double>::epsilon(),
+                               double a_max_weight = std::numeric_limits<double>::max());
+
+        //! Creation constructor (from c-type array)
+        /*!
+            Creates a new fenwick_roulette_wheel based on a set of weights.
+            \param a_weights - An array of weights defining the wheel
+            \param a_length - Number of elements in <i>a_weights</i>
+            \param a_min_weight - Minimum possible weight value (defaults to epsilon for type)
+            \param a_max_weight - Maximum possible weight value (defaults to max for type)
+        */
+        fenwick_roulette_wheel(const double * a_weights,
+                               size_t a_length,
+                               double a_min_weight = std::numeric_limits<double>::epsilon(),
+                               double a_max_weight = std::numeric_limits<double>::max());
+
+        //! Get size (number of weights)
+        /*!
+            Gets the number of weights indexed by the roulette wheel.
+            \return The number of weights
+        */
+        size_t get_size() const
+        {
+            return m_size;
+        }
+
+        //! Change the weight assigned to an entry
+        /*!
+            Changes the weight assigned to a specific wheel index.
+            \param a_index - Index to change
+            \param a_weight - New weight Value
+            \return Previous weight for this index
+        */
+        double set_weight(size_t a_index, double a_weight);
+
+        //! Get the weight for an index
+        /*!
+            Gets the weight assigned to a specific index.
+            \param a_index Index for which weight should be returned
+            \return Weight for this index
+        */
+        double get_weight(size_t a_index) const;
+
+        //! Retrieve a random index
+        /*!
+            Returns a randomly-selected index value, where the chance of
+            selecting each index is proportional to its weight.
+            \return A random index value
+        */
+        size_t get_index() const;
+
+    protected:
+        //! Number of weights in this wheel
+        size_t m_size;
+
+        //! Weights, after clamping
+        vector<double> m_weights;
+
+        //! Partial sums; element i (from 1) holds the sum of the (i & -i) weights ending at i - 1
+        vector<double> m_tree;
+
+        //! Total weight of all indexes
+        double m_total_weight;
+
+        //! Minimum possible weight value
+        double m_min_weight;
+
+        //! Maximum possible weight value
+        double m_max_weight;
+
+        //! Number of calls to set_weight since the tree was last rebuilt
+        size_t m_updates;
+
+    private:
+        // clamps and stores weights, then builds the tree
+        void init(const double * a_weights);
+
+        // recomputes the partial sums from the weights
+        void rebuild();
+    };
 };
 
 #endif
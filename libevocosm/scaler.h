@@ -104,6 +104,9 @@
 // libevocosm
 #include "organism.h"
 #include "stats.h"
+#include "generation_context.h"
+#include "population.h"
+#include "scaling.h"
 >>>>>>> version 4.0.2
 
 namespace libevocosm
@@ -142,6 +145,34 @@ namespace libevocosm
             \param a_population - A population of organisms
         */
         virtual void scale_fitness(vector<OrganismType> & a_population) = 0;
+
+        //! Scale a population's fitness values, with shared statistics
+        /*!
+            The evocosm calls this form, which lets a scaler use the generation's
+            shared statistics rather than computing its own; the evocosm
+            invalidates them afterward. By default, it calls the form above.
+            \param a_population - A population of organisms
+            \param a_context - Statistics for the generation, describing a_population
+        */
+        virtual void scale_fitness(vector<OrganismType> & a_population, generation_context<OrganismType> & a_context)
+        {
+            scale_fitness(a_population);
+        }
+
+        //! Scale an array of fitness values
+        /*!
+            Scales fitness stored apart from the organisms, such as the fitness
+            array of a soa_population, as the forms above scale a population.
+            <p>
+            The default implementation does nothing and returns <i>false</i>,
+            telling the caller that this form is not implemented.
+            \param a_fitness - Fitness values, by organism
+            \return <i>true</i> if the values were scaled; <i>false</i> if this form is not implemented
+        */
+        virtual bool scale_fitness(vector<double> & a_fitness)
+        {
+            return false;
+        }
 <<<<<<< 53bb9b38239f0b6fb908619d97286ae529277d0b
         
         //! Invert a population's fitness values
@@ -179,6 +210,17 @@ namespace libevocosm
         {
             // nada
         }
+
+        //! Do-nothing scaling function
+        /*!
+            Has no effect on the fitness values.
+            \param a_fitness - Fitness values, by organism
+            \return <i>true</i>
+        */
+        virtual bool scale_fitness(vector<double> & a_fitness)
+        {
+            return true;
+        }
     };
 
     //! A linear normalization scaler
@@ -207,6 +249,59 @@ namespace libevocosm
             \param a_population - A population of organisms
         */
         virtual void scale_fitness(vector<OrganismType> & a_population)
+        {
+            if (a_population.empty())
+                return;
+
+            // one fused pass finds the minimum, maximum, and mean fitness
+            vector<double> fitness;
+            scaling_tools::gather(a_population, fitness);
+
+            double min_fitness, max_fitness, avg_fitness;
+            scaling_tools::summarize(&fitness[0], fitness.size(), min_fitness, max_fitness, avg_fitness);
+
+            scale(a_population, &fitness, min_fitness, max_fitness, avg_fitness);
+        }
+
+        //! Scaling function, with shared statistics
+        /*!
+            Performs linear normalization on the fitness of the target population.
+            \param a_population - A population of organisms
+            \param a_context - Statistics for the generation
+        */
+        virtual void scale_fitness(vector<OrganismType> & a_population, generation_context<OrganismType> & a_context)
+        {
+            if (a_population.empty())
+                return;
+
+            const fitness_stats<OrganismType> & stats = a_context.get_stats();
+            scale(a_population, NULL, stats.getMin(), stats.getMax(), stats.getMean());
+        }
+
+        //! Scaling function, for an array of fitness values
+        /*!
+            Performs linear normalization on an array of fitness values.
+            \param a_fitness - Fitness values, by organism
+            \return <i>true</i>
+        */
+        virtual bool scale_fitness(vector<double> & a_fitness)
+        {
+            if (a_fitness.empty())
+                return true;
+
+            double min_fitness, max_fitness, avg_fitness;
+            scaling_tools::summarize(&a_fitness[0], a_fitness.size(), min_fitness, max_fitness, avg_fitness);
+
+            scale(a_fitness, &a_fitness, min_fitness, max_fitness, avg_fitness);
+            return true;
+        }
+
+    private:
+        // scales the fitness of a population or fitness array given its statistics;
+        // a_fitness, if not NULL, holds fitness values already gathered from it
+        template <class Target>
+        void scale(Target & a_population, vector<double> * a_fitness,
+                   double min_fitness, double max_fitness, double avg_fitness)
         {
             // calculate max, average, and minimum fitness for the population
 <<<<<<< 53bb9b38239f0b6fb908619d97286ae529277d0b
@@ -231,8 +326,6 @@ namespace libevocosm
             avg_fitness /= double(a_population.size());
             
 =======
-            fitness_stats<OrganismType> stats(a_population);
-
 >>>>>>> version 4.0.2
             // calculate coefficients for fitness scaling
             double slope;
@@ -248,12 +341,12 @@ namespace libevocosm
                 intercept = avg_fitness * (max_fitness - m_fitness_multiple * avg_fitness) / delta;
 =======
 
-            if (stats.getMin() > ((m_fitness_multiple * stats.getMean() - stats.getMax()) / (m_fitness_multiple - 1.0)))
+            if (min_fitness > ((m_fitness_multiple * avg_fitness - max_fitness) / (m_fitness_multiple - 1.0)))
             {
                 // normal scaling
-                delta = stats.getMax() - stats.getMean();
-                slope = (m_fitness_multiple - 1.0) * stats.getMean() / delta;
-                intercept = stats.getMean() * (stats.getMax() - m_fitness_multiple * stats.getMean()) / delta;
+                delta = max_fitness - avg_fitness;
+                slope = (m_fitness_multiple - 1.0) * avg_fitness / delta;
+                intercept = avg_fitness * (max_fitness - m_fitness_multiple * avg_fitness) / delta;
 >>>>>>> version 4.0.2
             }
             else
@@ -271,18 +364,26 @@ namespace libevocosm
         }
         
 =======
-                delta = stats.getMean() - stats.getMin();
-                slope = stats.getMean() / delta;
-                intercept = -stats.getMin() * stats.getMean() / delta;
+                delta = avg_fitness - min_fitness;
+                slope = avg_fitness / delta;
+                intercept = -min_fitness * avg_fitness / delta;
             }
 
             // adjust fitness values
-            for (int n = 0; n < a_population.size(); ++n)
-                a_population[n].fitness = slope * a_population[n].fitness + intercept;
+            if (a_fitness != NULL)
+            {
+                scaling_tools::affine(&(*a_fitness)[0], a_fitness->size(), slope, intercept);
+                scaling_tools::scatter(*a_fitness, a_population);
+            }
+            else
+            {
+                // copying out and back would cost more than the arithmetic saves
+                for (size_t n = 0; n < a_population.size(); ++n)
+                    fitness_access::at(a_population, n) = slope * fitness_access::get(a_population, n) + intercept;
+            }
         }
 
 >>>>>>> version 4.0.2
-    private:
         double m_fitness_multiple;
     };
 
@@ -325,11 +426,36 @@ namespace libevocosm
     };
     
 =======
-            fitness_stats<OrganismType> stats(a_population);
+            if (a_population.empty())
+                return;
+
+            vector<double> fitness;
+            scaling_tools::gather(a_population, fitness);
+
+            // find minimum fitness
+            double min_fitness, max_fitness, avg_fitness;
+            scaling_tools::summarize(&fitness[0], fitness.size(), min_fitness, max_fitness, avg_fitness);
 
             // assign new fitness values
-            for (int n = 0; n < a_population.size(); ++n)
-                a_population[n].fitness = stats.getMin();
+            scaling_tools::affine(&fitness[0], fitness.size(), 1.0, -min_fitness);
+            scaling_tools::scatter(fitness, a_population);
+        }
+
+        //! Scaling function, for an array of fitness values
+        /*!
+            Performs windowed scaling on an array of fitness values.
+            \param a_fitness - Fitness values, by organism
+            \return <i>true</i>
+        */
+        virtual bool scale_fitness(vector<double> & a_fitness)
+        {
+            if (a_fitness.empty())
+                return true;
+
+            double min_fitness, max_fitness, avg_fitness;
+            scaling_tools::summarize(&a_fitness[0], a_fitness.size(), min_fitness, max_fitness, avg_fitness);
+            scaling_tools::affine(&a_fitness[0], a_fitness.size(), 1.0, -min_fitness);
+            return true;
         }
     };
 
@@ -372,11 +498,27 @@ namespace libevocosm
             for (typename vector<OrganismType>::iterator org = a_population.begin(); org != a_population.end(); ++org)
                 org->fitness() = pow((m_a * org->fitness() + m_b),m_power);
 =======
-            for (int n = 0; n < a_population.size(); ++n)
-                a_population[n].fitness = pow((m_a * a_population[n].fitness + m_b),m_power);
+            scaling_tools::transform(a_population, [this](double * a_values, size_t a_count)
+            {
+                scaling_tools::power(a_values, a_count, m_a, m_b, m_power);
+            });
 >>>>>>> version 4.0.2
         }
 
+        //! Scaling function, for an array of fitness values
+        /*!
+            Performs exponential scaling on an array of fitness values.
+            \param a_fitness - Fitness values, by organism
+            \return <i>true</i>
+        */
+        virtual bool scale_fitness(vector<double> & a_fitness)
+        {
+            if (!a_fitness.empty())
+                scaling_tools::power(&a_fitness[0], a_fitness.size(), m_a, m_b, m_power);
+
+            return true;
+        }
+
     private:
         double m_a;
         double m_b;
@@ -423,15 +565,34 @@ namespace libevocosm
         }
         
 =======
-            for (int n = 0; n < a_population.size(); ++n)
-            {
-                double f = a_population[n].fitness;
-                a_population[n].fitness = m_a * pow(f,2.0) + m_b * f + m_c;
-            }
+            scale(a_population);
+        }
+
+        //! Scaling function, for an array of fitness values
+        /*!
+            Performs quadratic scaling on an array of fitness values.
+            \param a_fitness - Fitness values, by organism
+            \return <i>true</i>
+        */
+        virtual bool scale_fitness(vector<double> & a_fitness)
+        {
+            scale(a_fitness);
+            return true;
         }
 
 >>>>>>> version 4.0.2
     private:
+        // scales the fitness of a population or fitness array
+        template <class Target>
+        void scale(Target & a_population)
+        {
+            for (size_t n = 0; n < a_population.size(); ++n)
+            {
+                double f = fitness_access::get(a_population, n);
+                fitness_access::at(a_population, n) = m_a * (f * f) + m_b * f + m_c;
+            }
+        }
+
         double m_a;
         double m_b;
         double m_c;
@@ -464,6 +625,39 @@ namespace libevocosm
         */
         virtual void scale_fitness(vector<OrganismType> & a_population)
         {
+            fitness_stats<OrganismType> stats(a_population);
+            scale(a_population, stats);
+        }
+
+        //! Scaling function, with shared statistics
+        /*!
+            Performs sigma scaling on the fitness of the target population.
+            \param a_population - A population of organisms
+            \param a_context - Statistics for the generation
+        */
+        virtual void scale_fitness(vector<OrganismType> & a_population, generation_context<OrganismType> & a_context)
+        {
+            scale(a_population, a_context.get_stats());
+        }
+
+        //! Scaling function, for an array of fitness values
+        /*!
+            Performs sigma scaling on an array of fitness values.
+            \param a_fitness - Fitness values, by organism
+            \return <i>true</i>
+        */
+        virtual bool scale_fitness(vector<double> & a_fitness)
+        {
+            fitness_stats<OrganismType> stats(a_fitness);
+            scale(a_fitness, stats);
+            return true;
+        }
+
+    private:
+        // scales the fitness of a population or fitness array given its statistics
+        template <class Target>
+        void scale(Target & a_population, const fitness_stats<OrganismType> & stats)
+        {
 <<<<<<< 53bb9b38239f0b6fb908619d97286ae529277d0b
             // calculate the mean
             double mean = 0.0;
@@ -502,27 +696,27 @@ namespace libevocosm
                     if (org->fitness() < 0.1)
                         org->fitness() = 0.1;
 =======
-            fitness_stats<OrganismType> stats(a_population);
-
             // calculate 2 times the std. deviation (sigma)
             double sigma2 = 2.0 * stats.getSigma();
 
             // now assign new fitness values
             if (sigma2 == 0.0)
             {
-                for (int n = 0; n < a_population.size(); ++n)
-                    a_population[n].fitness = 1.0;
+                for (size_t n = 0; n < a_population.size(); ++n)
+                    fitness_access::at(a_population, n) = 1.0;
             }
             else
             {
-                for (int n = 0; n < a_population.size(); ++n)
+                for (size_t n = 0; n < a_population.size(); ++n)
                 {
+                    double & fitness = fitness_access::at(a_population, n);
+
                     // change fitness
-                    a_population[n].fitness = (1.0 + a_population[n].fitness / stats.mean) / sigma2;
+                    fitness = (1.0 + fitness / stats.getMean()) / sigma2;
 
                     // avoid tiny or zero fitness value; everyone gets to reproduce
-                    if (a_population[n].fitness < 0.1)
-                        a_population[n].fitness = 0.1;
+                    if (fitness < 0.1)
+                        fitness = 0.1;
 >>>>>>> version 4.0.2
                 }
             }
@@ -0,0 +1,204 @@
+/*
+    Evocosm is a C++ framework for implementing evolutionary algorithms.
+
+    Copyright 2011 Scott Robert Ladd. All rights reserved.
+
+    Evocosm is user-supported open source software. Its continued development is dependent
+    on financial support from the community. You can provide funding by visiting the Evocosm
+    website at:
+
+        http://www.coyotegulch.com
+
+    You may license Evocosm in one of two fashions:
+
+    1) Simplified BSD License (FreeBSD License)
+
+    Redistribution and use in source and binary forms, with or without modification, are
+    permitted provided that the following conditions are met:
+
+    1.  Redistributions of source code must retain the above copyright notice, this list of
+        conditions and the following disclaimer.
+
+    2.  Redistributions in binary form must reproduce the above copyright notice, this list
+        of conditions and the following disclaimer in the documentation and/or other materials
+        provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY SCOTT ROBERT LADD ``AS IS'' AND ANY EXPRESS OR IMPLIED
+    WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+    FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SCOTT ROBERT LADD OR
+    CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+    ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+    The views and conclusions contained in the software and documentation are those of the
+    authors and should not be interpreted as representing official policies, either expressed
+    or implied, of Scott Robert Ladd.
+
+    2) Closed-Source Proprietary License
+
+    If your project is a closed-source or proprietary project, the Simplified BSD License may
+    not be appropriate or desirable. In such cases, contact the Evocosm copyright holder to
+    arrange your purchase of an appropriate license.
+
+    The author can be contacted at:
+
+          scott.ladd@coyotegulch.com
+          scott.ladd@gmail.com
+          http:www.coyotegulch.com
+*/
+
+// Standard C++ Library
+#include <cmath>
+#include <cstring>
+
+// libevocosm
+#include "scaling.h"
+using namespace libevocosm;
+
+// Results must not depend on which version of a kernel runs, so keep the
+// compiler from fusing multiplies and adds where one target has FMA and
+// another doesn't.
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#pragma GCC optimize ("fp-contract=off")
+#endif
+
+// Build each kernel for several instruction sets, selected at load time.
+// This relies on GNU indirect functions, so it is limited to x86-64 Linux.
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && defined(__linux__)
+#define LIBEVOCOSM_KERNEL __attribute__((target_clones("avx512f","avx2","default")))
+#else
+#define LIBEVOCOSM_KERNEL
+#endif
+
+// Element-by-element loops are marked for vectorization, which OpenMP compilers
+// honor even where their cost model would hesitate.
+#if defined(_OPENMP)
+#define LIBEVOCOSM_SIMD _Pragma("omp simd")
+#else
+#define LIBEVOCOSM_SIMD
+#endif
+
+namespace
+{
+    // independent partial results in a reduction; enough to fill an AVX-512 register
+    const size_t LANES = 8;
+
+#if defined(__GNUC__) && !defined(__clang__)
+    // GCC keeps arrays of partial results in memory, which serializes the
+    // reduction; a vector type holds all lanes in registers
+    typedef double lanes_t __attribute__((vector_size(LANES * sizeof(double))));
+#endif
+}
+
+// minimum, maximum, and mean in one pass
+LIBEVOCOSM_KERNEL
+void scaling_tools::summarize(const double * a_values, size_t a_count, double & a_min, double & a_max, double & a_mean)
+{
+    double min[LANES];
+    double max[LANES];
+    double sum[LANES];
+
+    for (size_t l = 0; l < LANES; ++l)
+    {
+        min[l] = a_values[0];
+        max[l] = a_values[0];
+        sum[l] = 0.0;
+    }
+
+    size_t n = 0;
+
+#if defined(__GNUC__) && !defined(__clang__)
+    lanes_t vmin, vmax, vsum;
+    memcpy(&vmin, min, sizeof(vmin));
+    memcpy(&vmax, max, sizeof(vmax));
+    memcpy(&vsum, sum, sizeof(vsum));
+
+    for (; n + LANES <= a_count; n += LANES)
+    {
+        lanes_t v;
+        memcpy(&v, a_values + n, sizeof(v));
+        vmin = (v < vmin) ? v : vmin;
+        vmax = (v > vmax) ? v : vmax;
+        vsum += v;
+    }
+
+    memcpy(min, &vmin, sizeof(vmin));
+    memcpy(max, &vmax, sizeof(vmax));
+    memcpy(sum, &vsum, sizeof(vsum));
+#else
+    for (; n + LANES <= a_count; n += LANES)
+    {
+        for (size_t l = 0; l < LANES; ++l)
+        {
+            double v = a_values[n + l];
+            min[l] = (v < min[l]) ? v : min[l];
+            max[l] = (v > max[l]) ? v : max[l];
+            sum[l] += v;
+        }
+    }
+#endif
+
+    for (size_t l = 0; n < a_count; ++n, ++l)
+    {
+        double v = a_values[n];
+        min[l] = (v < min[l]) ? v : min[l];
+        max[l] = (v > max[l]) ? v : max[l];
+        sum[l] += v;
+    }
+
+    // combine lanes in a fixed order
+    double total = sum[0];
+    a_min = min[0];
+    a_max = max[0];
+
+    for (size_t l = 1; l < LANES; ++l)
+    {
+        a_min  = (min[l] < a_min) ? min[l] : a_min;
+        a_max  = (max[l] > a_max) ? max[l] : a_max;
+        total += sum[l];
+    }
+
+    a_mean = total / double(a_count);
+}
+
+// v = slope * v + intercept
+LIBEVOCOSM_KERNEL
+void scaling_tools::affine(double * a_values, size_t a_count, double a_slope, double a_intercept)
+{
+    LIBEVOCOSM_SIMD
+    for (size_t n = 0; n < a_count; ++n)
+        a_values[n] = a_slope * a_values[n] + a_intercept;
+}
+
+// v = (a * v + b)^power
+LIBEVOCOSM_KERNEL
+void scaling_tools::power(double * a_values, size_t a_count, double a_a, double a_b, double a_power)
+{
+    if (a_power == 2.0)
+    {
+        // pow(x,2.0) is exactly x * x
+        LIBEVOCOSM_SIMD
+        for (size_t n = 0; n < a_count; ++n)
+        {
+            double v = a_a * a_values[n] + a_b;
+            a_values[n] = v * v;
+        }
+    }
+    else if (a_power == 1.0)
+    {
+        LIBEVOCOSM_SIMD
+        for (size_t n = 0; n < a_count; ++n)
+            a_values[n] = a_a * a_values[n] + a_b;
+    }
+    else
+    {
+        for (size_t n = 0; n < a_count; ++n)
+            a_values[n] = pow(a_a * a_values[n] + a_b, a_power);
+    }
+}
+
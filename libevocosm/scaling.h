@@ -0,0 +1,191 @@
+/*
+    Evocosm is a C++ framework for implementing evolutionary algorithms.
+
+    Copyright 2011 Scott Robert Ladd. All rights reserved.
+
+    Evocosm is user-supported open source software. Its continued development is dependent
+    on financial support from the community. You can provide funding by visiting the Evocosm
+    website at:
+
+        http://www.coyotegulch.com
+
+    You may license Evocosm in one of two fashions:
+
+    1) Simplified BSD License (FreeBSD License)
+
+    Redistribution and use in source and binary forms, with or without modification, are
+    permitted provided that the following conditions are met:
+
+    1.  Redistributions of source code must retain the above copyright notice, this list of
+        conditions and the following disclaimer.
+
+    2.  Redistributions in binary form must reproduce the above copyright notice, this list
+        of conditions and the following disclaimer in the documentation and/or other materials
+        provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY SCOTT ROBERT LADD ``AS IS'' AND ANY EXPRESS OR IMPLIED
+    WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+    FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SCOTT ROBERT LADD OR
+    CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+    ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+    The views and conclusions contained in the software and documentation are those of the
+    authors and should not be interpreted as representing official policies, either expressed
+    or implied, of Scott Robert Ladd.
+
+    2) Closed-Source Proprietary License
+
+    If your project is a closed-source or proprietary project, the Simplified BSD License may
+    not be appropriate or desirable. In such cases, contact the Evocosm copyright holder to
+    arrange your purchase of an appropriate license.
+
+    The author can be contacted at:
+
+          scott.ladd@coyotegulch.com
+          scott.ladd@gmail.com
+          http:www.coyotegulch.com
+*/
+
+#if !defined(LIBEVOCOSM_SCALING_H)
+#define LIBEVOCOSM_SCALING_H
+
+// Standard C++ Library
+#include <cstddef>
+#include <vector>
+
+namespace libevocosm
+{
+    using std::vector;
+
+    //! Kernels for scaling arrays of fitness values
+    /*!
+        Scalers copy fitness values out of a population into a contiguous
+        array, transform the array with these kernels, and copy the results
+        back. Working on a plain array lets the compiler use vector
+        instructions; where the compiler supports it, each kernel is built
+        for several instruction sets (AVX-512, AVX2, and a generic baseline),
+        and the best one available is chosen when the program starts.
+        <p>
+        Copying costs about as much as a cheap transformation of the fitness
+        stored in each organism, so the kernels pay off for reductions and
+        for expensive functions such as pow.
+        <p>
+        The kernels give the same results whichever version runs: reductions
+        use a fixed number of partial sums combined in a fixed order, and
+        multiplies are never fused with adds.
+    */
+    class scaling_tools
+    {
+    public:
+        //! Copy fitness values out of a population
+        /*!
+            \param a_population - A population of organisms
+            \param a_fitness - Receives the fitness of each organism, in order
+        */
+        template <class OrganismType>
+        static void gather(const vector<OrganismType> & a_population, vector<double> & a_fitness)
+        {
+            a_fitness.resize(a_population.size());
+
+            for (size_t n = 0; n < a_population.size(); ++n)
+                a_fitness[n] = a_population[n].fitness;
+        }
+
+        //! Copy fitness values back into a population
+        /*!
+            \param a_fitness - Fitness for each organism, in order
+            \param a_population - A population of organisms
+        */
+        template <class OrganismType>
+        static void scatter(const vector<double> & a_fitness, vector<OrganismType> & a_population)
+        {
+            for (size_t n = 0; n < a_population.size(); ++n)
+                a_population[n].fitness = a_fitness[n];
+        }
+
+        //! Copy fitness values into another array
+        /*!
+            Lets code written for populations work on a fitness array, such as
+            that of a soa_population; copying an array onto itself does nothing.
+            \param a_fitness - Fitness values
+            \param a_values - Receives the values
+        */
+        static void scatter(const vector<double> & a_fitness, vector<double> & a_values)
+        {
+            if (&a_fitness != &a_values)
+                a_values = a_fitness;
+        }
+
+        //! Apply a kernel to the fitness of every organism
+        /*!
+            Copies fitness values into a small buffer a block at a time, calls
+            the kernel on the buffer, and copies the results back.
+            \param a_population - A population of organisms
+            \param a_kernel - Called as a_kernel(double * values, size_t count)
+        */
+        template <class OrganismType, class Kernel>
+        static void transform(vector<OrganismType> & a_population, Kernel a_kernel)
+        {
+            double block[TRANSFORM_BLOCK];
+
+            for (size_t start = 0; start < a_population.size(); start += TRANSFORM_BLOCK)
+            {
+                size_t count = a_population.size() - start;
+
+                if (count > TRANSFORM_BLOCK)
+                    count = TRANSFORM_BLOCK;
+
+                for (size_t n = 0; n < count; ++n)
+                    block[n] = a_population[start + n].fitness;
+
+                a_kernel(block, count);
+
+                for (size_t n = 0; n < count; ++n)
+                    a_population[start + n].fitness = block[n];
+            }
+        }
+
+        //! Find the minimum, maximum, and mean in one pass
+        /*!
+            \param a_values - Array of values
+            \param a_count - Number of values; must be greater than zero
+            \param a_min - Receives the smallest value
+            \param a_max - Receives the largest value
+            \param a_mean - Receives the mean
+        */
+        static void summarize(const double * a_values, size_t a_count, double & a_min, double & a_max, double & a_mean);
+
+        //! Apply a linear transformation
+        /*!
+            Replaces each value <i>v</i> with <i>slope * v + intercept</i>.
+            \param a_values - Array of values
+            \param a_count - Number of values
+            \param a_slope - Multiplier
+            \param a_intercept - Offset
+        */
+        static void affine(double * a_values, size_t a_count, double a_slope, double a_intercept);
+
+        //! Raise a linear transformation to a power
+        /*!
+            Replaces each value <i>v</i> with <i>(a * v + b)<sup>power</sup></i>.
+            Powers of one and two, the most common, are computed by multiplication,
+            which vectorizes; other powers call pow for each value.
+            \param a_values - Array of values
+            \param a_count - Number of values
+            \param a_a - Multiplier
+            \param a_b - Offset
+            \param a_power - Exponent
+        */
+        static void power(double * a_values, size_t a_count, double a_a, double a_b, double a_power);
+
+    private:
+        // fitness values per block in transform; small enough to stay in L1 cache
+        static const size_t TRANSFORM_BLOCK = 256;
+    };
+};
+
+#endif
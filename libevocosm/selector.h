@@ -91,9 +91,15 @@
 
 // Standard C++ Library
 #include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <stdexcept>
 
 // libevocosm
 #include "organism.h"
+#include "generation_context.h"
+#include "population.h"
 
 namespace libevocosm
 {
@@ -132,10 +138,77 @@ namespace libevocosm
         /*!
             Produces a vector containing copies of the organisms selected for
             survival.
+            <p>
+            By default, this function is an adapter that copies the organisms
+            chosen by the index form of select_survivors. A selector must override
+            at least one of the two.
             \param a_population - A population of organisms
             \return A population of copied survivors
         */
-        virtual vector<OrganismType> select_survivors(vector<OrganismType> & a_population) = 0;
+        virtual vector<OrganismType> select_survivors(vector<OrganismType> & a_population)
+        {
+            vector<size_t> indexes;
+
+            if (!select_survivors(a_population, indexes))
+                throw std::runtime_error("selector does not implement select_survivors");
+
+            vector<OrganismType> result;
+            result.reserve(indexes.size());
+
+            for (size_t n = 0; n < indexes.size(); ++n)
+                result.push_back(a_population[indexes[n]]);
+
+            return result;
+        }
+
+        //! Select the indexes of individuals that survive
+        /*!
+            Chooses survivors without copying them, by filling a vector with
+            their indexes in the population. Indexes appear in the order the
+            survivors would have been copied; an index may appear more than once.
+            <p>
+            The default implementation does nothing and returns <i>false</i>,
+            telling the caller to use the copying form of select_survivors instead.
+            \param a_population - A population of organisms
+            \param a_survivors - Receives the indexes of survivors, replacing its contents
+            \return <i>true</i> if survivors were selected; <i>false</i> if this form is not implemented
+        */
+        virtual bool select_survivors(const vector<OrganismType> & a_population, vector<size_t> & a_survivors)
+        {
+            return false;
+        }
+
+        //! Select the indexes of individuals that survive, with shared statistics
+        /*!
+            The evocosm calls this form, which lets a selector use the generation's
+            shared statistics rather than computing its own. By default, it calls
+            the form above.
+            \param a_population - A population of organisms
+            \param a_survivors - Receives the indexes of survivors, replacing its contents
+            \param a_context - Statistics for the generation, describing a_population
+            \return <i>true</i> if survivors were selected; <i>false</i> if index selection is not implemented
+        */
+        virtual bool select_survivors(const vector<OrganismType> & a_population, vector<size_t> & a_survivors, generation_context<OrganismType> & a_context)
+        {
+            return select_survivors(a_population, a_survivors);
+        }
+
+        //! Select the indexes of survivors from an array of fitness values
+        /*!
+            Chooses survivors from fitness stored apart from the organisms, such
+            as the fitness array of a soa_population, as the index form above
+            chooses them from a population.
+            <p>
+            The default implementation does nothing and returns <i>false</i>,
+            telling the caller that this form is not implemented.
+            \param a_fitness - Fitness values, by organism
+            \param a_survivors - Receives the indexes of survivors, replacing its contents
+            \return <i>true</i> if survivors were selected; <i>false</i> if this form is not implemented
+        */
+        virtual bool select_survivors(const vector<double> & a_fitness, vector<size_t> & a_survivors)
+        {
+            return false;
+        }
     };
 
     //! A do-nothing selector
@@ -157,6 +230,32 @@ namespace libevocosm
         {
             return vector<OrganismType>(); // an empty vector
         }
+
+        // Do-nothing selection function
+        /*!
+            Selects no survivors.
+            \param a_population - A population of organisms
+            \param a_survivors - Emptied
+            \return <i>true</i>
+        */
+        virtual bool select_survivors(const vector<OrganismType> & a_population, vector<size_t> & a_survivors)
+        {
+            a_survivors.clear();
+            return true;
+        }
+
+        // Do-nothing selection function
+        /*!
+            Selects no survivors.
+            \param a_fitness - Fitness values, by organism
+            \param a_survivors - Emptied
+            \return <i>true</i>
+        */
+        virtual bool select_survivors(const vector<double> & a_fitness, vector<size_t> & a_survivors)
+        {
+            a_survivors.clear();
+            return true;
+        }
     };
 
 <<<<<<< 53bb9b38239f0b6fb908619d97286ae529277d0b
@@ -186,6 +285,42 @@ namespace libevocosm
 
             return result;
         }
+
+        // Do-nothing selection function
+        /*!
+            Selects every organism.
+            \param a_population - A population of organisms
+            \param a_survivors - Receives every index in the population
+            \return <i>true</i>
+        */
+        virtual bool select_survivors(const vector<OrganismType> & a_population, vector<size_t> & a_survivors)
+        {
+            pick(a_population.size(), a_survivors);
+            return true;
+        }
+
+        // Do-nothing selection function
+        /*!
+            Selects every organism.
+            \param a_fitness - Fitness values, by organism
+            \param a_survivors - Receives every index in the array
+            \return <i>true</i>
+        */
+        virtual bool select_survivors(const vector<double> & a_fitness, vector<size_t> & a_survivors)
+        {
+            pick(a_fitness.size(), a_survivors);
+            return true;
+        }
+
+    private:
+        // selects every index below a_size
+        static void pick(size_t a_size, vector<size_t> & a_survivors)
+        {
+            a_survivors.clear();
+
+            for (size_t n = 0; n < a_size; ++n)
+                a_survivors.push_back(n);
+        }
     };
 
     //! Implements a elitism selector
@@ -256,7 +391,43 @@ namespace libevocosm
         */
         virtual vector<OrganismType> select_survivors(vector<OrganismType> & a_population);
 
+        //! Select the indexes of individuals that survive
+        /*!
+            Chooses the survivors without copying them.
+            \param a_population - A population of organisms
+            \param a_survivors - Receives the indexes of survivors, replacing its contents
+            \return <i>true</i>
+        */
+        virtual bool select_survivors(const vector<OrganismType> & a_population, vector<size_t> & a_survivors);
+
+        //! Select the indexes of individuals that survive, with shared statistics
+        /*!
+            Chooses the survivors without copying them, using the generation's statistics.
+            \param a_population - A population of organisms
+            \param a_survivors - Receives the indexes of survivors, replacing its contents
+            \param a_context - Statistics for the generation
+            \return <i>true</i>
+        */
+        virtual bool select_survivors(const vector<OrganismType> & a_population, vector<size_t> & a_survivors, generation_context<OrganismType> & a_context)
+        {
+            pick(a_population, a_survivors, a_context.get_stats());
+            return true;
+        }
+
+        //! Select the indexes of survivors from an array of fitness values
+        /*!
+            Chooses the survivors from fitness stored apart from the organisms.
+            \param a_fitness - Fitness values, by organism
+            \param a_survivors - Receives the indexes of survivors, replacing its contents
+            \return <i>true</i>
+        */
+        virtual bool select_survivors(const vector<double> & a_fitness, vector<size_t> & a_survivors);
+
     private:
+        // picks survivors from a population or fitness array given its statistics
+        template <class Source>
+        void pick(const Source & a_population, vector<size_t> & a_survivors, const fitness_stats<OrganismType> & a_stats);
+
         // number of organisms to keep
 <<<<<<< 53bb9b38239f0b6fb908619d97286ae529277d0b
         size_t m_how_many;
@@ -315,6 +486,321 @@ namespace libevocosm
         return chosen_ones;
     }
 
+    template <class OrganismType>
+    bool elitism_selector<OrganismType>::select_survivors(const vector<OrganismType> & a_population, vector<size_t> & a_survivors)
+    {
+        // get population stats
+        fitness_stats<OrganismType> stats(a_population);
+
+        pick(a_population, a_survivors, stats);
+        return true;
+    }
+
+    template <class OrganismType>
+    bool elitism_selector<OrganismType>::select_survivors(const vector<double> & a_fitness, vector<size_t> & a_survivors)
+    {
+        // get fitness stats
+        fitness_stats<OrganismType> stats(a_fitness);
+
+        pick(a_fitness, a_survivors, stats);
+        return true;
+    }
+
+    template <class OrganismType>
+    template <class Source>
+    void elitism_selector<OrganismType>::pick(const Source & a_population, vector<size_t> & a_survivors, const fitness_stats<OrganismType> & a_stats)
+    {
+        a_survivors.clear();
+
+        // calculate survival based on percentage of best fitness
+        double threshold = m_factor * a_stats.getMax();
+
+        // pick survivors
+        for (size_t n = 0; n < a_population.size(); ++n)
+        {
+            if (fitness_access::get(a_population, n) > threshold)
+                a_survivors.push_back(n);
+        }
+    }
+
+    //! Implements a count-based elitism selector
+    /*!
+        The top_k_selector keeps exactly the <i>k</i> best organisms (or the
+        whole population, if it is smaller), so the number of survivors is known
+        before selection. It finds the <i>k</i>th best fitness by partial
+        selection rather than sorting the population, then takes every organism
+        above it. Ties at that fitness go to the organisms with the lowest
+        indexes, and fitness that is not a number ranks with negative infinity,
+        so the same population always yields the same survivors.
+        \param OrganismType - The type of organism
+    */
+    template <class OrganismType>
+    class top_k_selector : public selector<OrganismType>
+    {
+    public:
+        //! Constructor
+        /*!
+            Constructs a new top_k_selector.
+            \param a_how_many - The number of survivors
+        */
+        top_k_selector(size_t a_how_many = 1)
+            : m_how_many(a_how_many)
+        {
+            // nada
+        }
+
+        //! Get the number of survivors
+        /*!
+            \return The number of organisms selected from a population at least that large
+        */
+        size_t get_how_many() const
+        {
+            return m_how_many;
+        }
+
+        // the copying form of select_survivors is the base class adapter
+        using selector<OrganismType>::select_survivors;
+
+        //! Select the indexes of individuals that survive
+        /*!
+            Chooses the best organisms without copying them. Indexes are in
+            increasing order.
+            \param a_population - A population of organisms
+            \param a_survivors - Receives the indexes of survivors, replacing its contents
+            \return <i>true</i>
+        */
+        virtual bool select_survivors(const vector<OrganismType> & a_population, vector<size_t> & a_survivors)
+        {
+            pick(a_population, a_survivors);
+            return true;
+        }
+
+        //! Select the indexes of survivors from an array of fitness values
+        /*!
+            Chooses the best organisms from fitness stored apart from them.
+            Indexes are in increasing order.
+            \param a_fitness - Fitness values, by organism
+            \param a_survivors - Receives the indexes of survivors, replacing its contents
+            \return <i>true</i>
+        */
+        virtual bool select_survivors(const vector<double> & a_fitness, vector<size_t> & a_survivors)
+        {
+            pick(a_fitness, a_survivors);
+            return true;
+        }
+
+    private:
+        // picks survivors from a population or fitness array
+        template <class Source>
+        void pick(const Source & a_population, vector<size_t> & a_survivors);
+
+        // fitness used for ranking; NaN would break the ordering nth_element requires
+        static double rank(double a_fitness)
+        {
+            return std::isnan(a_fitness) ? -std::numeric_limits<double>::infinity() : a_fitness;
+        }
+
+        // moves the a_count highest values of [a_begin, a_end) to its front, in no particular order
+        static void keep_highest(vector<double>::iterator a_begin, vector<double>::iterator a_end, size_t a_count)
+        {
+            if (size_t(a_end - a_begin) > a_count)
+                std::nth_element(a_begin, a_begin + a_count, a_end, std::greater<double>());
+        }
+
+        // values per block when blocks are searched in parallel
+        static const size_t BLOCK_SIZE = 65536;
+
+        // fewer blocks than this aren't worth starting threads for
+        static const size_t PARALLEL_BLOCKS = 4;
+
+        // number of organisms to keep
+        size_t m_how_many;
+    };
+
+    template <class OrganismType>
+    template <class Source>
+    void top_k_selector<OrganismType>::pick(const Source & a_population, vector<size_t> & a_survivors)
+    {
+        a_survivors.clear();
+
+        size_t size  = a_population.size();
+        size_t count = (m_how_many < size) ? m_how_many : size;
+
+        if (count == 0)
+            return;
+
+        vector<double> values(size);
+
+        for (size_t n = 0; n < size; ++n)
+            values[n] = rank(fitness_access::get(a_population, n));
+
+        // find the lowest fitness that survives
+        size_t num_blocks = (size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+        if ((num_blocks >= PARALLEL_BLOCKS) && (count < BLOCK_SIZE / 2))
+        {
+            // the best values overall are among the best of each block
+          #if defined(_OPENMP)
+            #pragma omp parallel for schedule(static)
+          #endif
+            for (int b = 0; b < (int)num_blocks; ++b)
+            {
+                size_t begin = size_t(b) * BLOCK_SIZE;
+                size_t end   = (begin + BLOCK_SIZE < size) ? begin + BLOCK_SIZE : size;
+                keep_highest(values.begin() + begin, values.begin() + end, count);
+            }
+
+            // pack each block's candidates together
+            size_t packed = 0;
+
+            for (size_t b = 0; b < num_blocks; ++b)
+            {
+                size_t begin = b * BLOCK_SIZE;
+                size_t end   = (begin + BLOCK_SIZE < size) ? begin + BLOCK_SIZE : size;
+                size_t keep  = (end - begin < count) ? end - begin : count;
+
+                std::copy(values.begin() + begin, values.begin() + begin + keep, values.begin() + packed);
+                packed += keep;
+            }
+
+            values.resize(packed);
+        }
+
+        std::nth_element(values.begin(), values.begin() + (count - 1), values.end(), std::greater<double>());
+        double threshold = values[count - 1];
+
+        // organisms above the threshold all survive; those at it fill the remaining places
+        size_t above = 0;
+
+        for (size_t n = 0; n < count; ++n)
+        {
+            if (values[n] > threshold)
+                ++above;
+        }
+
+        size_t ties = count - above;
+
+        a_survivors.reserve(count);
+
+        for (size_t n = 0; n < size; ++n)
+        {
+            double fitness = rank(fitness_access::get(a_population, n));
+
+            if (fitness > threshold)
+                a_survivors.push_back(n);
+            else if ((fitness == threshold) && (ties > 0))
+            {
+                a_survivors.push_back(n);
+                --ties;
+            }
+        }
+    }
+
+    //! Implements tournament selection
+    /*!
+        Each survivor is the winner of a tournament among organisms chosen at
+        random, with replacement; the organism with the highest fitness wins,
+        and the first one drawn wins a tie. Only comparisons of fitness matter,
+        so tournament selection needs no scaled fitness and no roulette wheel.
+        An organism may survive more than once.
+        \param OrganismType - The type of organism
+    */
+    template <class OrganismType>
+    class tournament_selector : public selector<OrganismType>
+    {
+    public:
+        //! Constructor
+        /*!
+            Constructs a new tournament_selector.
+            \param a_how_many - The number of survivors
+            \param a_tournament_size - Number of contestants in each tournament; at least one
+        */
+        tournament_selector(size_t a_how_many = 1, size_t a_tournament_size = 2)
+            : m_how_many(a_how_many),
+              m_tournament_size(a_tournament_size > 0 ? a_tournament_size : 1)
+        {
+            // nada
+        }
+
+        //! Get the number of survivors
+        size_t get_how_many() const
+        {
+            return m_how_many;
+        }
+
+        //! Get the number of contestants in each tournament
+        size_t get_tournament_size() const
+        {
+            return m_tournament_size;
+        }
+
+        // the copying form of select_survivors is the base class adapter
+        using selector<OrganismType>::select_survivors;
+
+        //! Select the indexes of individuals that survive
+        /*!
+            Holds one tournament for each survivor, selecting none from an
+            empty population and no more than the population holds.
+            \param a_population - A population of organisms
+            \param a_survivors - Receives the indexes of survivors, replacing its contents
+            \return <i>true</i>
+        */
+        virtual bool select_survivors(const vector<OrganismType> & a_population, vector<size_t> & a_survivors)
+        {
+            pick(a_population, a_survivors);
+            return true;
+        }
+
+        //! Select the indexes of survivors from an array of fitness values
+        /*!
+            Holds one tournament for each survivor among fitness values stored
+            apart from the organisms.
+            \param a_fitness - Fitness values, by organism
+            \param a_survivors - Receives the indexes of survivors, replacing its contents
+            \return <i>true</i>
+        */
+        virtual bool select_survivors(const vector<double> & a_fitness, vector<size_t> & a_survivors)
+        {
+            pick(a_fitness, a_survivors);
+            return true;
+        }
+
+    private:
+        // holds the tournaments over a population or fitness array
+        template <class Source>
+        void pick(const Source & a_population, vector<size_t> & a_survivors)
+        {
+            a_survivors.clear();
+
+            if (a_population.size() == 0)
+                return;
+
+            // never pick more survivors than there are organisms
+            size_t how_many = std::min(m_how_many, (size_t)a_population.size());
+            a_survivors.reserve(how_many);
+
+            for (size_t n = 0; n < how_many; ++n)
+            {
+                size_t winner = globals::g_random.get_index(a_population.size());
+
+                for (size_t t = 1; t < m_tournament_size; ++t)
+                {
+                    size_t contestant = globals::g_random.get_index(a_population.size());
+
+                    if (fitness_access::get(a_population, contestant) > fitness_access::get(a_population, winner))
+                        winner = contestant;
+                }
+
+                a_survivors.push_back(winner);
+            }
+        }
+
+        // number of organisms to keep
+        size_t m_how_many;
+
+        // contestants per tournament
+        size_t m_tournament_size;
+    };
 };
 
 #endif
@@ -0,0 +1,271 @@
+/*
+    Evocosm is a C++ framework for implementing evolutionary algorithms.
+
+    Copyright 2011 Scott Robert Ladd. All rights reserved.
+
+    Evocosm is user-supported open source software. Its continued development is dependent
+    on financial support from the community. You can provide funding by visiting the Evocosm
+    website at:
+
+        http://www.coyotegulch.com
+
+    You may license Evocosm in one of two fashions:
+
+    1) Simplified BSD License (FreeBSD License)
+
+    Redistribution and use in source and binary forms, with or without modification, are
+    permitted provided that the following conditions are met:
+
+    1.  Redistributions of source code must retain the above copyright notice, this list of
+        conditions and the following disclaimer.
+
+    2.  Redistributions in binary form must reproduce the above copyright notice, this list
+        of conditions and the following disclaimer in the documentation and/or other materials
+        provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY SCOTT ROBERT LADD ``AS IS'' AND ANY EXPRESS OR IMPLIED
+    WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+    FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SCOTT ROBERT LADD OR
+    CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+    ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+    The views and conclusions contained in the software and documentation are those of the
+    authors and should not be interpreted as representing official policies, either expressed
+    or implied, of Scott Robert Ladd.
+
+    2) Closed-Source Proprietary License
+
+    If your project is a closed-source or proprietary project, the Simplified BSD License may
+    not be appropriate or desirable. In such cases, contact the Evocosm copyright holder to
+    arrange your purchase of an appropriate license.
+
+    The author can be contacted at:
+
+          scott.ladd@coyotegulch.com
+          scott.ladd@gmail.com
+          http:www.coyotegulch.com
+*/
+
+#if !defined(LIBEVOCOSM_SERIALIZER_H)
+#define LIBEVOCOSM_SERIALIZER_H
+
+// Standard C++ Library
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace libevocosm
+{
+    //! Writes and reads a type in binary form
+    /*!
+        A serializer streams a value to and from the compact binary form used
+        by checkpoints. Values are written in the machine's native byte order,
+        without padding. Each specialization provides:
+
+        <code>static void write(std::ostream & a_stream, const T & a_value);</code><br>
+        <code>static T read(std::istream & a_stream);</code>
+
+        The primary template is declared but not defined: a type must provide
+        a specialization before it can be checkpointed. Specializations for
+        arithmetic types and vectors of them live here; those for the state
+        machines live beside the types they serialize.
+        \param T - The type being serialized
+    */
+    template <typename T, typename Enable = void>
+    struct serializer;
+
+    //! Tools for writing serializers
+    class serializer_tools
+    {
+    public:
+        //! Writes raw bytes
+        /*!
+            \param a_stream - Output stream
+            \param a_data - Bytes to write
+            \param a_size - Number of bytes
+        */
+        static void write_bytes(std::ostream & a_stream, const void * a_data, size_t a_size)
+        {
+            if (!a_stream.write(static_cast<const char *>(a_data), (std::streamsize)a_size))
+                throw std::runtime_error("checkpoint write failed");
+        }
+
+        //! Reads raw bytes
+        /*!
+            \param a_stream - Input stream
+            \param a_data - Receives the bytes
+            \param a_size - Number of bytes
+        */
+        static void read_bytes(std::istream & a_stream, void * a_data, size_t a_size)
+        {
+            if (!a_stream.read(static_cast<char *>(a_data), (std::streamsize)a_size))
+                throw std::runtime_error("checkpoint truncated or unreadable");
+        }
+
+        //! Writes a size or count
+        /*!
+            Sizes are always written as 64-bit values, so that checkpoints do not
+            depend on the width of size_t.
+            \param a_stream - Output stream
+            \param a_size - The value to write
+        */
+        static void write_size(std::ostream & a_stream, size_t a_size)
+        {
+            uint64_t value = a_size;
+            write_bytes(a_stream, &value, sizeof(value));
+        }
+
+        //! Reads a size or count
+        /*!
+            \param a_stream - Input stream
+            \return The value read
+        */
+        static size_t read_size(std::istream & a_stream)
+        {
+            uint64_t value;
+            read_bytes(a_stream, &value, sizeof(value));
+            return (size_t)value;
+        }
+
+        //! Reads a count of stored elements
+        /*!
+            Reads a count written by write_size and checks it against what the
+            stream can still supply, so that a corrupt or truncated checkpoint
+            fails cleanly instead of requesting a huge allocation. On streams
+            that cannot seek, only overflow is checked; readers of such streams
+            should grow their containers as elements arrive.
+            \param a_stream - Input stream
+            \param a_bytes_each - Minimum number of bytes stored per element
+            \return The count read
+        */
+        static size_t read_count(std::istream & a_stream, size_t a_bytes_each)
+        {
+            uint64_t value;
+            read_bytes(a_stream, &value, sizeof(value));
+
+            if ((a_bytes_each > 0) && (value > (uint64_t)SIZE_MAX / a_bytes_each))
+                throw std::runtime_error("checkpoint corrupt: element count overflows");
+
+            std::streampos here = a_stream.tellg();
+
+            if (here != std::streampos(-1))
+            {
+                a_stream.seekg(0, std::ios::end);
+                std::streampos end = a_stream.tellg();
+                a_stream.seekg(here);
+
+                if (!a_stream)
+                    throw std::runtime_error("checkpoint truncated or unreadable");
+
+                if ((end != std::streampos(-1)) && (value * a_bytes_each > (uint64_t)(end - here)))
+                    throw std::runtime_error("checkpoint corrupt: element count exceeds stored data");
+            }
+
+            return (size_t)value;
+        }
+
+        //! Number of elements a reader allocates at a time when it cannot seek
+        static const size_t READ_CHUNK = 65536;
+    };
+
+    //! Serializes arithmetic types
+    template <typename T>
+    struct serializer<T, typename std::enable_if<std::is_arithmetic<T>::value>::type>
+    {
+        //! Writes a value
+        static void write(std::ostream & a_stream, const T & a_value)
+        {
+            serializer_tools::write_bytes(a_stream, &a_value, sizeof(T));
+        }
+
+        //! Reads a value
+        static T read(std::istream & a_stream)
+        {
+            T result;
+            serializer_tools::read_bytes(a_stream, &result, sizeof(T));
+            return result;
+        }
+    };
+
+    //! Serializes vectors of arithmetic types
+    /*!
+        Writes the length, then the elements as a single block, so that large
+        vectors such as the genes of function_solution stream without copying.
+    */
+    template <typename T>
+    struct serializer<std::vector<T>, typename std::enable_if<std::is_arithmetic<T>::value>::type>
+    {
+        //! Writes a vector
+        static void write(std::ostream & a_stream, const std::vector<T> & a_value)
+        {
+            serializer_tools::write_size(a_stream, a_value.size());
+
+            if (!a_value.empty())
+                serializer_tools::write_bytes(a_stream, &a_value[0], a_value.size() * sizeof(T));
+        }
+
+        //! Reads a vector
+        /*!
+            The stored length is validated before anything is allocated, and
+            the elements are read in bounded chunks, so a corrupt length fails
+            on the stream rather than on memory.
+        */
+        static std::vector<T> read(std::istream & a_stream)
+        {
+            size_t count = serializer_tools::read_count(a_stream, sizeof(T));
+            std::vector<T> result;
+
+            while (result.size() < count)
+            {
+                size_t done  = result.size();
+                size_t chunk = count - done;
+
+                if (chunk > serializer_tools::READ_CHUNK)
+                    chunk = serializer_tools::READ_CHUNK;
+
+                result.resize(done + chunk);
+                serializer_tools::read_bytes(a_stream, &result[done], chunk * sizeof(T));
+            }
+
+            return result;
+        }
+    };
+
+    //! Serializes organisms
+    /*!
+        Writes an organism's fitness and genes; other members of classes derived
+        from organism are not saved, and are default-initialized on reading. The
+        organism type must be constructible from an rvalue of its genotype, as
+        organism and function_solution are.
+        \param OrganismType - The type of organism
+    */
+    template <class OrganismType>
+    struct organism_serializer
+    {
+        //! Writes an organism
+        static void write(std::ostream & a_stream, const OrganismType & a_organism)
+        {
+            serializer<double>::write(a_stream, a_organism.fitness);
+            serializer<typename OrganismType::genotype_t>::write(a_stream, a_organism.genes);
+        }
+
+        //! Reads an organism
+        static OrganismType read(std::istream & a_stream)
+        {
+            double fitness = serializer<double>::read(a_stream);
+            OrganismType result(serializer<typename OrganismType::genotype_t>::read(a_stream));
+            result.fitness = fitness;
+            return result;
+        }
+    };
+};
+
+#endif
@@ -62,6 +62,9 @@ using namespace std;
 // libevocosm
 #include "evocommon.h"
 #include "machine_tools.h"
+#include "genome_hash.h"
+#include "genome_pool.h"
+#include "serializer.h"
 
 namespace libevocosm
 {
@@ -71,6 +74,9 @@ namespace libevocosm
         integer input and output types. This is much faster than the generic
         fsm class because the transition table can be represented as a simple
         two-dimensional array.
+        <p>
+        The table is a single block, with the row pointers followed by the
+        transitions for every state, allocated from the genome_pool.
         \param InputSize Number of input states
         \param OutputSize Number of output states
     */
@@ -110,6 +116,14 @@ namespace libevocosm
         */
         simple_machine(const simple_machine<InSize,OutSize> & a_source);
 
+        //! Move constructor
+        /*!
+            Creates a new simple_machine that takes over the state table of an
+            existing one, leaving the source with no states.
+            \param a_source - Object to be moved
+        */
+        simple_machine(simple_machine<InSize,OutSize> && a_source);
+
         //! Virtual destructor
         /*!
             Does nothing in the base class; exists to allow destruction of derived
@@ -125,6 +139,15 @@ namespace libevocosm
         */
         simple_machine & operator = (const simple_machine<InSize,OutSize> & a_source);
 
+        //  Move assignment
+        /*!
+            Takes over the state table of an existing simple_machine, leaving
+            the source with no states.
+            \param a_source - Object to be moved
+            \return A reference to the target object
+        */
+        simple_machine & operator = (simple_machine<InSize,OutSize> && a_source);
+
         //!  Mutation
         /*!
             Mutates a finite state machine object. The four mutations supported are:
@@ -209,6 +232,18 @@ namespace libevocosm
         size_t current_state() const;
 
     private:
+        // selects the constructor that allocates without randomizing
+        struct allocate_only_t { };
+
+        // allocates an unfilled table; used by readers, which must not draw random numbers
+        simple_machine(size_t a_size, allocate_only_t);
+
+        // size of the table block for a given number of states
+        static size_t table_bytes(size_t a_size);
+
+        // allocate the state table for m_size states
+        void allocate();
+
         // release resources
         void release();
 
@@ -230,20 +265,56 @@ namespace libevocosm
 
         //!  Global mutation selector
         static mutation_selector g_selector;
+
+        //!  Checkpoints read and write the table in place
+        friend struct serializer< simple_machine<InSize,OutSize> >;
     };
 
     //  Static initializer
     template <size_t InSize, size_t OutSize>
     typename simple_machine<InSize,OutSize>::mutation_selector simple_machine<InSize,OutSize>::g_selector;
 
+    // size of the table block
+    template <size_t InSize, size_t OutSize>
+    inline size_t simple_machine<InSize,OutSize>::table_bytes(size_t a_size)
+    {
+        return a_size * (sizeof(tranout_t *) + InSize * sizeof(tranout_t));
+    }
+
+    // allocate the state table
+    template <size_t InSize, size_t OutSize>
+    void simple_machine<InSize,OutSize>::allocate()
+    {
+        // row pointers come first, then the transitions they point to
+        m_state_table = static_cast<tranout_t **>(genome_pool::allocate(table_bytes(m_size)));
+
+        tranout_t * row = reinterpret_cast<tranout_t *>(m_state_table + m_size);
+
+        for (size_t s = 0; s < m_size; ++s, row += InSize)
+            m_state_table[s] = row;
+    }
+
     // release resources
     template <size_t InSize, size_t OutSize>
     void simple_machine<InSize,OutSize>::release()
     {
-        for (size_t s = 0; s < m_size; ++s)
-            delete [] m_state_table[s];
+        genome_pool::release(m_state_table, table_bytes(m_size));
+        m_state_table = NULL;
+    }
 
-        delete [] m_state_table;
+    // allocate-only constructor
+    template <size_t InSize, size_t OutSize>
+    simple_machine<InSize,OutSize>::simple_machine(size_t a_size, allocate_only_t)
+      : m_state_table(NULL),
+        m_init_state(0),
+        m_current_state(0),
+        m_size(a_size)
+    {
+        // verify parameters
+        if (m_size < 2)
+            throw std::runtime_error("invalid simple_machine creation parameters");
+
+        allocate();
     }
 
     // deep copy
@@ -251,13 +322,10 @@ namespace libevocosm
     void simple_machine<InSize,OutSize>::deep_copy(const simple_machine<InSize,OutSize> & a_source)
     {
         // allocate state table
-        m_state_table = new tranout_t * [m_size];
+        allocate();
 
         for (size_t s = 0; s < m_size; ++s)
         {
-            // allocate an array corresponding to inputs
-            m_state_table[s] = new tranout_t [InSize];
-
             // set transition values
             for (size_t i = 0; i < InSize; ++i)
             {
@@ -280,13 +348,10 @@ namespace libevocosm
             throw std::runtime_error("invalid simple_machine creation parameters");
 
         // allocate state table
-        m_state_table = new tranout_t * [m_size];
+        allocate();
 
         for (size_t s = 0; s < m_size; ++s)
         {
-            // allocate an array corresponding to inputs
-            m_state_table[s] = new tranout_t [InSize];
-
             // set transition values
             for (size_t i = 0; i < InSize; ++i)
             {
@@ -350,6 +415,19 @@ namespace libevocosm
         deep_copy(a_source);
     }
 
+    //  Move constructor
+    template <size_t InSize, size_t OutSize>
+    simple_machine<InSize,OutSize>::simple_machine(simple_machine<InSize,OutSize> && a_source)
+      : m_state_table(a_source.m_state_table),
+        m_init_state(a_source.m_init_state),
+        m_current_state(a_source.m_current_state),
+        m_size(a_source.m_size)
+    {
+        // the source gives up its table
+        a_source.m_state_table = NULL;
+        a_source.m_size        = 0;
+    }
+
     //  Virtual destructor
     template <size_t InSize, size_t OutSize>
     simple_machine<InSize,OutSize>::~simple_machine()
@@ -375,6 +453,28 @@ namespace libevocosm
         return *this;
     }
 
+    //  Move assignment
+    template <size_t InSize, size_t OutSize>
+    simple_machine<InSize,OutSize> & simple_machine<InSize,OutSize>::operator = (simple_machine<InSize,OutSize> && a_source)
+    {
+        if (this != &a_source)
+        {
+            // release resources
+            release();
+
+            // take over the source's table
+            m_state_table   = a_source.m_state_table;
+            m_init_state    = a_source.m_init_state;
+            m_current_state = a_source.m_current_state;
+            m_size          = a_source.m_size;
+
+            a_source.m_state_table = NULL;
+            a_source.m_size        = 0;
+        }
+
+        return *this;
+    }
+
     //! Set a mutation weight
     template <size_t InSize, size_t OutSize>
     inline void simple_machine<InSize,OutSize>::set_mutation_weight(mutation_id a_type, double a_weight)
@@ -434,10 +534,6 @@ namespace libevocosm
                         // mutate state transition
                         size_t state  = rand_index(m_size);
 
-                        // allocate an array corresponding to inputs
-                        delete [] m_state_table[state];
-                        m_state_table[state] = new tranout_t [InSize];
-
                         // set transition values
                         for (size_t i = 0; i < InSize; ++i)
                         {
@@ -551,6 +647,93 @@ namespace libevocosm
     {
         return m_current_state;
     }
+
+    //! Hashes a simple_machine
+    /*!
+        Hashes the initial state and transition table of a simple_machine; the
+        current state is ignored, since machines are reset before they are tested.
+    */
+    template <size_t InSize, size_t OutSize>
+    struct genome_hash< simple_machine<InSize,OutSize> >
+    {
+        //! Computes the hash
+        /*!
+            \param a_genes - Machine to be hashed
+            \return 64-bit hash of a_genes
+        */
+        uint64_t operator () (const simple_machine<InSize,OutSize> & a_genes) const
+        {
+            uint64_t result = genome_hash_tools::mix(genome_hash_tools::HASH_SEED, (uint64_t)a_genes.size());
+            result = genome_hash_tools::mix(result, (uint64_t)a_genes.init_state());
+
+            for (size_t s = 0; s < a_genes.size(); ++s)
+            {
+                for (size_t i = 0; i < InSize; ++i)
+                {
+                    const typename simple_machine<InSize,OutSize>::tranout_t & tran = a_genes.get_transition(s,i);
+                    result = genome_hash_tools::mix(result, ((uint64_t)tran.m_new_state << 16) ^ (uint64_t)tran.m_output);
+                }
+            }
+
+            return result;
+        }
+    };
+
+    //! Serializes a simple_machine
+    template <size_t InSize, size_t OutSize>
+    struct serializer< simple_machine<InSize,OutSize> >
+    {
+        //! Writes a machine
+        static void write(std::ostream & a_stream, const simple_machine<InSize,OutSize> & a_machine)
+        {
+            serializer_tools::write_size(a_stream, a_machine.m_size);
+            serializer_tools::write_size(a_stream, a_machine.m_init_state);
+            serializer_tools::write_size(a_stream, a_machine.m_current_state);
+
+            for (size_t s = 0; s < a_machine.m_size; ++s)
+            {
+                for (size_t i = 0; i < InSize; ++i)
+                {
+                    serializer_tools::write_size(a_stream, a_machine.m_state_table[s][i].m_new_state);
+                    serializer_tools::write_size(a_stream, a_machine.m_state_table[s][i].m_output);
+                }
+            }
+        }
+
+        //! Reads a machine
+        static simple_machine<InSize,OutSize> read(std::istream & a_stream)
+        {
+            // allocate a table of the stored size without touching the random stream
+            size_t size = serializer_tools::read_count(a_stream, InSize * 2 * sizeof(uint64_t));
+            simple_machine<InSize,OutSize> result(size, typename simple_machine<InSize,OutSize>::allocate_only_t());
+
+            result.m_init_state    = read_index(a_stream, size);
+            result.m_current_state = read_index(a_stream, size);
+
+            for (size_t s = 0; s < size; ++s)
+            {
+                for (size_t i = 0; i < InSize; ++i)
+                {
+                    result.m_state_table[s][i].m_new_state = read_index(a_stream, size);
+                    result.m_state_table[s][i].m_output    = read_index(a_stream, OutSize);
+                }
+            }
+
+            return result;
+        }
+
+    private:
+        // reads a state or output index, rejecting values a valid machine cannot hold
+        static size_t read_index(std::istream & a_stream, size_t a_limit)
+        {
+            size_t index = serializer_tools::read_size(a_stream);
+
+            if (index >= a_limit)
+                throw std::runtime_error("checkpoint corrupt: simple_machine index out of range");
+
+            return index;
+        }
+    };
 };
 
 #endif
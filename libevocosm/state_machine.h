@@ -59,12 +59,16 @@
 #include <map>
 #include <stack>
 #include <stdexcept>
+#include <functional>
+#include <utility>
 using namespace std;
 
 // libevocosm
 #include "evocommon.h"
 #include "roulette.h"
 #include "machine_tools.h"
+#include "genome_hash.h"
+#include "serializer.h"
 
 namespace libevocosm
 {
@@ -84,7 +88,7 @@ namespace libevocosm
         \param OutputT Output type
     */
     template <typename InputT, typename OutputT>
-    class state_machine : protected globals, protected fsm_tools
+    class state_machine : protected globals, protected machine_tools
     {
     public:
         //! Exported input type
@@ -131,6 +135,14 @@ namespace libevocosm
         */
         state_machine(const state_machine<InputT,OutputT> & a_source);
 
+        //! Move constructor
+        /*!
+            Creates a new state_machine that takes over the state table of an
+            existing one.
+            \param a_source - Object to be moved
+        */
+        state_machine(state_machine<InputT,OutputT> && a_source);
+
         //! Virtual destructor
         /*!
             Does nothing in the base class; exists to allow destruction of derived
@@ -145,6 +157,13 @@ namespace libevocosm
         */
         state_machine & operator = (const state_machine<InputT,OutputT> & a_source);
 
+        //  Move assignment
+        /*!
+            Takes over the state table of an existing state_machine.
+            \param a_source - Object to be moved
+        */
+        state_machine & operator = (state_machine<InputT,OutputT> && a_source);
+
         //!  Mutation
         /*!
             Mutates a finite state machine object. The four mutations supported are:
@@ -215,7 +234,19 @@ namespace libevocosm
         //!  A static, default mutation selector
         static mutation_selector g_default_selector;
 
+        //!  Hashing reads the table in place, rather than copying it via get_table
+        friend struct genome_hash< state_machine<InputT,OutputT> >;
+
+        //!  Checkpoints read and write the table in place
+        friend struct serializer< state_machine<InputT,OutputT> >;
+
     private:
+        // selects the constructor that allocates without randomizing
+        struct allocate_only_t { };
+
+        // creates a machine of empty states; used by readers, which must not draw random numbers
+        state_machine(size_t a_size, allocate_only_t);
+
         // create a state map
         t_input_map create_input_map(const std::vector<t_input> & a_inputs, const std::vector<t_output> & a_outputs);
     };
@@ -292,6 +323,17 @@ namespace libevocosm
         // nada
     }
 
+    //  Move constructor
+    template <typename InputT, typename OutputT>
+    state_machine<InputT,OutputT>::state_machine(state_machine<InputT,OutputT> && a_source)
+      : m_state_table(std::move(a_source.m_state_table)),
+        m_init_state(a_source.m_init_state),
+        m_current_state(a_source.m_current_state),
+        m_size(a_source.m_size)
+    {
+        a_source.m_size = 0;
+    }
+
     //  Virtual destructor
     template <typename InputT, typename OutputT>
     state_machine<InputT,OutputT>::~state_machine()
@@ -314,6 +356,23 @@ namespace libevocosm
         return *this;
     }
 
+    //  Move assignment
+    template <typename InputT, typename OutputT>
+    state_machine<InputT,OutputT> & state_machine<InputT,OutputT>::operator = (state_machine<InputT,OutputT> && a_source)
+    {
+        if (this != &a_source)
+        {
+            m_state_table   = std::move(a_source.m_state_table);
+            m_init_state    = a_source.m_init_state;
+            m_current_state = a_source.m_current_state;
+            m_size          = a_source.m_size;
+
+            a_source.m_size = 0;
+        }
+
+        return *this;
+    }
+
     //  Mutation
     template <typename InputT, typename OutputT>
     void state_machine<InputT,OutputT>::mutate(double a_rate,
@@ -420,6 +479,19 @@ namespace libevocosm
         return m_current_state;
     }
 
+    //  Allocate-only constructor
+    template <typename InputT, typename OutputT>
+    state_machine<InputT,OutputT>::state_machine(size_t a_size, allocate_only_t)
+      : m_state_table(a_size),
+        m_size(a_size),
+        m_init_state(0),
+        m_current_state(0)
+    {
+        // verify parameters
+        if (a_size < 2)
+            throw std::runtime_error("invalid state_machine creation parameters");
+    }
+
     // create a state map
     template <typename InputT, typename OutputT>
     typename state_machine<InputT,OutputT>::t_input_map state_machine<InputT,OutputT>::create_input_map(const std::vector<t_input> & a_inputs, const std::vector<t_output> & a_outputs)
@@ -443,6 +515,113 @@ namespace libevocosm
 
         return input_map;
     }
+
+    //! Hashes a state_machine
+    /*!
+        Hashes the initial state and transition table of a state_machine; the
+        current state is ignored, since machines are reset before they are tested.
+        Inputs and outputs are hashed with std::hash, which must therefore be
+        defined for InputT and OutputT.
+    */
+    template <typename InputT, typename OutputT>
+    struct genome_hash< state_machine<InputT,OutputT> >
+    {
+        //! Computes the hash
+        /*!
+            \param a_genes - Machine to be hashed
+            \return 64-bit hash of a_genes
+        */
+        uint64_t operator () (const state_machine<InputT,OutputT> & a_genes) const
+        {
+            std::hash<InputT>  hash_input;
+            std::hash<OutputT> hash_output;
+
+            uint64_t result = genome_hash_tools::mix(genome_hash_tools::HASH_SEED, (uint64_t)a_genes.m_size);
+            result = genome_hash_tools::mix(result, (uint64_t)a_genes.m_init_state);
+
+            for (typename state_machine<InputT,OutputT>::t_state_table::const_iterator state = a_genes.m_state_table.begin(); state != a_genes.m_state_table.end(); ++state)
+            {
+                result = genome_hash_tools::mix(result, (uint64_t)state->size());
+
+                for (typename state_machine<InputT,OutputT>::t_input_map::const_iterator tran = state->begin(); tran != state->end(); ++tran)
+                {
+                    result = genome_hash_tools::mix(result, (uint64_t)hash_input(tran->first));
+                    result = genome_hash_tools::mix(result, (uint64_t)hash_output(tran->second.first));
+                    result = genome_hash_tools::mix(result, (uint64_t)tran->second.second);
+                }
+            }
+
+            return result;
+        }
+    };
+
+    //! Serializes a state_machine
+    /*!
+        Inputs and outputs are written with serializer<InputT> and
+        serializer<OutputT>, which must therefore be defined.
+    */
+    template <typename InputT, typename OutputT>
+    struct serializer< state_machine<InputT,OutputT> >
+    {
+        //! Writes a machine
+        static void write(std::ostream & a_stream, const state_machine<InputT,OutputT> & a_machine)
+        {
+            serializer_tools::write_size(a_stream, a_machine.m_size);
+            serializer_tools::write_size(a_stream, a_machine.m_init_state);
+            serializer_tools::write_size(a_stream, a_machine.m_current_state);
+
+            for (typename state_machine<InputT,OutputT>::t_state_table::const_iterator state = a_machine.m_state_table.begin(); state != a_machine.m_state_table.end(); ++state)
+            {
+                serializer_tools::write_size(a_stream, state->size());
+
+                for (typename state_machine<InputT,OutputT>::t_input_map::const_iterator tran = state->begin(); tran != state->end(); ++tran)
+                {
+                    serializer<InputT>::write(a_stream, tran->first);
+                    serializer<OutputT>::write(a_stream, tran->second.first);
+                    serializer_tools::write_size(a_stream, tran->second.second);
+                }
+            }
+        }
+
+        //! Reads a machine
+        static state_machine<InputT,OutputT> read(std::istream & a_stream)
+        {
+            // create empty states without touching the random stream
+            size_t size = serializer_tools::read_count(a_stream, sizeof(uint64_t));
+            state_machine<InputT,OutputT> result(size, typename state_machine<InputT,OutputT>::allocate_only_t());
+
+            result.m_init_state    = read_state(a_stream, size);
+            result.m_current_state = read_state(a_stream, size);
+
+            for (size_t s = 0; s < size; ++s)
+            {
+                size_t count = serializer_tools::read_count(a_stream, sizeof(uint64_t));
+
+                for (size_t n = 0; n < count; ++n)
+                {
+                    InputT  input  = serializer<InputT>::read(a_stream);
+                    OutputT output = serializer<OutputT>::read(a_stream);
+                    size_t  state  = read_state(a_stream, size);
+
+                    result.m_state_table[s][input] = std::make_pair(output, state);
+                }
+            }
+
+            return result;
+        }
+
+    private:
+        // reads a state index, rejecting values a valid machine cannot hold
+        static size_t read_state(std::istream & a_stream, size_t a_size)
+        {
+            size_t state = serializer_tools::read_size(a_stream);
+
+            if (state >= a_size)
+                throw std::runtime_error("checkpoint corrupt: state_machine state out of range");
+
+            return state;
+        }
+    };
 };
 
 #endif
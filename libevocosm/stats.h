@@ -55,12 +55,18 @@
 
 // libevocosm
 #include "organism.h"
+#include "population.h"
 
 // Standard C Library
 #include <cmath>
 
 // Standard C++
 #include <limits>
+#include <stdexcept>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
 
 namespace libevocosm
 {
@@ -68,116 +74,250 @@ namespace libevocosm
     /*!
         Produces a set of basic statistics from a given population. Used by various
         scaling, analysis, and reporting algorithms.
+        <p>
+        The population is read once, without copying any organisms; the best and
+        worst organisms are remembered by index, and the mean and variance are
+        accumulated in the same pass. Large populations are divided into
+        fixed-size blocks that OpenMP threads scan in parallel; the partial
+        results are combined in block order with the pairwise update of Chan
+        et al., so the statistics do not depend on the number of threads.
+        <p>
+        A fitness_stats object refers to the population it analyzed, which must
+        not be changed or destroyed while getBest and getWorst are in use.
         \param OrganismType The type of organism in the population
      */
     template <class OrganismType>
     class fitness_stats
     {
     private:
+        // statistics for a range of the population
+        struct partial
+        {
+            size_t count;
+            double mean;
+            double m2;
+            double min;
+            double max;
+            size_t min_index;
+            size_t max_index;
+        };
+
+        // organisms per block; fixed, so the results are reproducible
+        static const size_t BLOCK_SIZE = 4096;
+
+        // fewer blocks than this aren't worth starting threads for
+        static const size_t PARALLEL_BLOCKS = 8;
 
         double min;
         double max;
         double mean;
         double variance;
         double sigma;
-        OrganismType * best;
-        OrganismType * worst;
+        const vector<OrganismType> * population;
+        size_t best_index;
+        size_t worst_index;
 
-    public:
-
-        //! Construct a statistics object for a specific population
-        /*!
-            Analyzes a population, find highest and lowest fitness
-            organisms and computing various statistical values.
-
-            \param a_population Population ot be analyzed.
-         */
-        fitness_stats(const vector<OrganismType> & a_population)
-          : best(new OrganismType(a_population[0])),
-            worst(new OrganismType(a_population[0]))
+        // one pass over [a_begin, a_end) of a population or fitness array
+        template <class Source>
+        static partial scan(const Source & a_population, size_t a_begin, size_t a_end)
         {
-            // calculate max, average, and minimum fitness for the population
-            max = std::numeric_limits<double>::min();
-            min = std::numeric_limits<double>::max();
-            mean = 0.0;
-            variance = 0.0;
-
-            for (int n = 0; n < a_population.size(); ++n)
+            partial result;
+            result.count     = a_end - a_begin;
+            result.min       = std::numeric_limits<double>::max();
+            result.max       = -std::numeric_limits<double>::max();
+            result.min_index = a_begin;
+            result.max_index = a_begin;
+
+            // sums of deviations from the block's first value; shifting keeps the
+            // sum of squares from swamping the variance, and unlike a running mean
+            // costs no division per organism
+            double shift = fitness_access::get(a_population, a_begin);
+            double sum   = 0.0;
+            double sum2  = 0.0;
+
+            for (size_t n = a_begin; n < a_end; ++n)
             {
+                double fitness = fitness_access::get(a_population, n);
+
                 // do we have a new maximum?
-                if (a_population[n].fitness > max)
+                if (fitness > result.max)
                 {
-                    max = a_population[n].fitness;
-
-                    if (best != NULL)
-                        delete best;
-
-                    best = new OrganismType(a_population[n]);
+                    result.max = fitness;
+                    result.max_index = n;
                 }
 
                 // do we have a new minimum?
-                if (a_population[n].fitness < min)
+                if (fitness < result.min)
                 {
-                    min = a_population[n].fitness;
+                    result.min = fitness;
+                    result.min_index = n;
+                }
+
+                double delta = fitness - shift;
+                sum  += delta;
+                sum2 += delta * delta;
+            }
 
-                    if (worst != NULL)
-                        delete worst;
+            result.mean = shift + sum / double(result.count);
+            result.m2   = sum2 - sum * (sum / double(result.count));
 
-                    worst = new OrganismType(a_population[n]);
-                }
+            if (result.m2 < 0.0)
+                result.m2 = 0.0;
+
+            return result;
+        }
 
-                // accumulate for average
-                mean += a_population[n].fitness;
+        // combines the statistics of a later range into those of an earlier one (Chan et al.)
+        static void merge(partial & a_total, const partial & a_part)
+        {
+            if (a_part.count == 0)
+                return;
+
+            if (a_part.max > a_total.max)
+            {
+                a_total.max = a_part.max;
+                a_total.max_index = a_part.max_index;
+            }
+
+            if (a_part.min < a_total.min)
+            {
+                a_total.min = a_part.min;
+                a_total.min_index = a_part.min_index;
             }
 
-            mean /= double(a_population.size());
+            size_t count = a_total.count + a_part.count;
+            double delta = a_part.mean - a_total.mean;
+
+            a_total.mean += delta * (double(a_part.count) / double(count));
+            a_total.m2   += a_part.m2 + delta * delta * (double(a_total.count) * double(a_part.count) / double(count));
+            a_total.count = count;
+        }
 
-            for (int n = 0; n < a_population.size(); ++n)
+        // computes the statistics of a population or fitness array
+        template <class Source>
+        void analyze(const Source & a_population)
+        {
+            if (a_population.empty())
+                throw std::runtime_error("fitness_stats requires a non-empty population");
+
+            size_t size = a_population.size();
+            size_t num_blocks = (size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+            partial total;
+
+            if (num_blocks == 1)
+                total = scan(a_population, 0, size);
+            else
             {
-                double diff = a_population[n].fitness - mean;
-                variance += (diff * diff);
+                vector<partial> parts(num_blocks);
+
+              #if defined(_OPENMP)
+                #pragma omp parallel for schedule(static) if (num_blocks >= PARALLEL_BLOCKS)
+              #endif
+                for (int b = 0; b < (int)num_blocks; ++b)
+                {
+                    size_t begin = size_t(b) * BLOCK_SIZE;
+                    size_t end   = (begin + BLOCK_SIZE < size) ? begin + BLOCK_SIZE : size;
+                    parts[b] = scan(a_population, begin, end);
+                }
+
+                total = parts[0];
+
+                for (size_t b = 1; b < num_blocks; ++b)
+                    merge(total, parts[b]);
             }
 
-            variance /= static_cast<double>(a_population.size() - 1);
+            max  = total.max;
+            min  = total.min;
+            mean = total.mean;
+            best_index  = total.max_index;
+            worst_index = total.min_index;
+
+            if (total.count > 1)
+                variance = total.m2 / static_cast<double>(total.count - 1);
 
-            // calculate 2 times the std. deviation (sigma)
+            // calculate the std. deviation (sigma)
             sigma = sqrt(variance);
         }
 
+    public:
+
+        //! Construct a statistics object for a specific population
+        /*!
+            Analyzes a population, find highest and lowest fitness
+            organisms and computing various statistical values.
+
+            \param a_population Population ot be analyzed.
+         */
+        fitness_stats(const vector<OrganismType> & a_population)
+          : min(0.0),
+            max(0.0),
+            mean(0.0),
+            variance(0.0),
+            sigma(0.0),
+            population(&a_population),
+            best_index(0),
+            worst_index(0)
+        {
+            analyze(a_population);
+        }
+
+        //! Construct a statistics object for an array of fitness values
+        /*!
+            Analyzes fitness stored apart from the organisms, such as the fitness
+            array of a soa_population. The statistics have no organisms to refer
+            to, so getBest and getWorst must not be called; use getBestIndex and
+            getWorstIndex instead.
+            \param a_fitness Fitness values to be analyzed.
+         */
+        fitness_stats(const vector<double> & a_fitness)
+          : min(0.0),
+            max(0.0),
+            mean(0.0),
+            variance(0.0),
+            sigma(0.0),
+            population(NULL),
+            best_index(0),
+            worst_index(0)
+        {
+            analyze(a_fitness);
+        }
+
         //! Destructor
         /*!
             Frees resources.
         */
         virtual ~fitness_stats()
         {
-            if (best != NULL)
-                delete best;
-
-            if (worst != NULL)
-                delete worst;
+            // nada
         }
 
-
         //! Get the minimum fitness value for analyzed population
-        double getMin() { return min; }
+        double getMin() const { return min; }
 
         //! Get the maximum fitness value for analyzed population
-        double getMax() { return max; }
+        double getMax() const { return max; }
 
         //! Get the mean (average) fitness value for analyzed population
-        double getMean() { return mean; }
+        double getMean() const { return mean; }
 
         //! Get the fitness variance for analyzed population
-        double getVariance() { return variance; }
+        double getVariance() const { return variance; }
 
         //! Get the standard deviation (sigma) value for fitness
-        double getSigma() { return sigma; }
+        double getSigma() const { return sigma; }
 
         //! Get the organism with the highest fitness for analyzed population
-        OrganismType getBest() { return *best; }
+        const OrganismType & getBest() const { return (*population)[best_index]; }
 
         //! Get the organism with the lowest fitness for analyzed population
-        OrganismType getWorst() { return *worst; }
+        const OrganismType & getWorst() const { return (*population)[worst_index]; }
+
+        //! Get the index of the organism with the highest fitness; the first, if there are several
+        size_t getBestIndex() const { return best_index; }
+
+        //! Get the index of the organism with the lowest fitness; the first, if there are several
+        size_t getWorstIndex() const { return worst_index; }
     };
 
 };
@@ -0,0 +1,532 @@
+/*
+    Evocosm is a C++ framework for implementing evolutionary algorithms.
+
+    Copyright 2011 Scott Robert Ladd. All rights reserved.
+
+    Evocosm is user-supported open source software. Its continued development is dependent
+    on financial support from the community. You can provide funding by visiting the Evocosm
+    website at:
+
+        http://www.coyotegulch.com
+
+    You may license Evocosm in one of two fashions:
+
+    1) Simplified BSD License (FreeBSD License)
+
+    Redistribution and use in source and binary forms, with or without modification, are
+    permitted provided that the following conditions are met:
+
+    1.  Redistributions of source code must retain the above copyright notice, this list of
+        conditions and the following disclaimer.
+
+    2.  Redistributions in binary form must reproduce the above copyright notice, this list
+        of conditions and the following disclaimer in the documentation and/or other materials
+        provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY SCOTT ROBERT LADD ``AS IS'' AND ANY EXPRESS OR IMPLIED
+    WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+    FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SCOTT ROBERT LADD OR
+    CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+    ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+    The views and conclusions contained in the software and documentation are those of the
+    authors and should not be interpreted as representing official policies, either expressed
+    or implied, of Scott Robert Ladd.
+
+    2) Closed-Source Proprietary License
+
+    If your project is a closed-source or proprietary project, the Simplified BSD License may
+    not be appropriate or desirable. In such cases, contact the Evocosm copyright holder to
+    arrange your purchase of an appropriate license.
+
+    The author can be contacted at:
+
+          scott.ladd@coyotegulch.com
+          scott.ladd@gmail.com
+          http:www.coyotegulch.com
+*/
+
+#if !defined(LIBEVOCOSM_STEADY_STATE_H)
+#define LIBEVOCOSM_STEADY_STATE_H
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+// Standard C++ Library
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+// libevocosm
+#include "evocommon.h"
+#include "organism.h"
+#include "landscape.h"
+#include "mutator.h"
+#include "reproducer.h"
+#include "analyzer.h"
+#include "listener.h"
+#include "generation_context.h"
+
+namespace libevocosm
+{
+    using std::vector;
+
+    //! How a steady_state engine chooses the organism a child replaces
+    enum replacement_policy
+    {
+        REPLACE_WORST,      //!< Replace the least-fit organism in the population
+        REPLACE_TOURNAMENT  //!< Replace the least-fit of a few randomly-chosen organisms
+    };
+
+    //! A steady-state evolutionary engine
+    /*!
+        Where an evocosm replaces its entire population each generation, a
+        steady-state engine replaces organisms one at a time. Worker threads
+        repeatedly breed a child, mutate it, test it, and insert it into the
+        population in place of an existing organism. No thread waits for the
+        others to finish a generation, so all of them stay busy even when
+        testing times vary widely.
+
+        The engine reuses the reproducer, mutator and landscape interfaces
+        of an evocosm. Workers breed from a snapshot of the population, taken
+        every quarter epoch, so breeding, mutation and testing all run without
+        a lock; the reproducer, mutator and test(OrganismType &) must be safe
+        to call from several threads at once, as they must be for
+        evocosm::set_breed_threads. Only claiming children and storing them
+        take a lock on the population, and both cost a constant time per child:
+        when the policy is REPLACE_WORST, each snapshot comes with a list of its
+        least-fit organisms, and children replace them in order.
+        <p>
+        Landscapes that only define a population-wide test, such as tournaments,
+        can not be used. Breeding sees raw fitness values, since there is no
+        generation at which to scale them; reproducers that pick parents by
+        roulette wheel need non-negative fitness.
+
+        Progress is reported in epochs, each being as many insertions as there
+        are organisms in the population. At the end of each epoch, the worker
+        that completed it calls the listener's ping_generation_end and the
+        analyzer's analyze, with the epoch number in place of a generation number;
+        both are called with the population locked, never concurrently.
+        \param OrganismType - The type of organism
+    */
+    template <class OrganismType>
+    class steady_state : protected globals
+    {
+    public:
+        //! Creation constructor
+        /*!
+            Creates a new steady-state engine. The referenced objects must
+            continue to exist during the lifetime of the engine.
+            \param a_population - A population of organisms
+            \param a_landscape - A fitness landscape
+            \param a_mutator - A mutation operator
+            \param a_reproducer - A reproduction operator
+            \param a_analyzer - An analyzer, asked after each epoch whether to continue
+            \param a_listener - An event listener
+            \param a_policy - How children choose the organisms they replace
+            \param a_tournament_size - Number of organisms in a replacement tournament
+        */
+        steady_state(vector<OrganismType>    & a_population,
+                     landscape<OrganismType> & a_landscape,
+                     mutator<OrganismType>   & a_mutator,
+                     reproducer<OrganismType> & a_reproducer,
+                     analyzer<OrganismType>  & a_analyzer,
+                     listener<OrganismType>  & a_listener,
+                     replacement_policy a_policy = REPLACE_WORST,
+                     size_t a_tournament_size = 2)
+          : m_population(a_population),
+            m_landscape(a_landscape),
+            m_mutator(a_mutator),
+            m_reproducer(a_reproducer),
+            m_analyzer(a_analyzer),
+            m_listener(a_listener),
+            m_policy(a_policy),
+            m_tournament_size(a_tournament_size > 0 ? a_tournament_size : 1),
+            m_batch_size(0),
+            m_batch(1),
+            m_num_threads(0),
+            m_tested(false),
+            m_evaluations(0),
+            m_issued(0),
+            m_epoch(0),
+            m_runs(0),
+            m_stop(false),
+            m_mutex(),
+            m_snapshot(),
+            m_victims(),
+            m_next_victim(0),
+            m_until_refresh(0)
+        {
+            // nada
+        }
+
+        //! Virtual destructor
+        virtual ~steady_state()
+        {
+            // nada
+        }
+
+        //! Run for a number of evaluations
+        /*!
+            Breeds, tests and inserts a given number of children, or fewer if the
+            analyzer decides evolution is complete. The first run begins by testing
+            the initial population.
+            \param a_evaluations - Number of children to test
+            \return <i>true</i> if evolution should continue; <i>false</i> if the run is complete
+        */
+        bool run(size_t a_evaluations)
+        {
+            if (m_population.size() < 2)
+                return false;
+
+            if (!m_tested)
+            {
+                m_landscape.test(m_population);
+                m_tested = true;
+            }
+
+            size_t target = m_evaluations + a_evaluations;
+            uint64_t run  = m_runs++;
+
+            m_issued = m_evaluations;
+            m_stop   = false;
+
+          #if defined(_OPENMP)
+            int threads = (m_num_threads > 0) ? (int)m_num_threads : omp_get_max_threads();
+          #else
+            int threads = 1;
+          #endif
+
+            // by default, larger batches for more workers keep the lock rate steady
+            m_batch = (m_batch_size > 0) ? m_batch_size : (size_t)threads;
+
+            refresh();
+
+          #if defined(_OPENMP)
+            #pragma omp parallel num_threads(threads)
+          #endif
+            {
+              #if defined(_OPENMP)
+                uint64_t thread = (uint64_t)omp_get_thread_num();
+              #else
+                uint64_t thread = 0;
+              #endif
+
+                // each worker draws from its own random stream; the calling
+                // thread, which is one of them, gets its own stream back after
+                stream_scope stream(STEADY_STREAM_BASE + (run << 16) + thread);
+
+                work(target);
+            }
+
+            return !m_stop;
+        }
+
+        //! Get the number of evaluations
+        /*!
+            \return Number of children tested and inserted so far
+        */
+        size_t get_evaluations() const
+        {
+            return m_evaluations;
+        }
+
+        //! Get the number of epochs
+        /*!
+            \return Number of completed epochs (population-sized sets of insertions)
+        */
+        size_t get_epoch() const
+        {
+            return m_epoch;
+        }
+
+        //! Get the batch size
+        /*!
+            \return Number of children a worker breeds each time it locks the population; zero means automatic
+        */
+        size_t get_batch_size() const
+        {
+            return m_batch_size;
+        }
+
+        //! Set the batch size
+        /*!
+            Sets the number of children a worker breeds, tests and inserts at a
+            time. Larger batches take the lock less often, at the cost of holding
+            it longer. The default, zero, uses one child per worker thread, so
+            the lock is taken about as often whatever the number of threads.
+            \param a_batch_size - Number of children per batch; zero for automatic
+        */
+        void set_batch_size(size_t a_batch_size)
+        {
+            m_batch_size = a_batch_size;
+        }
+
+        //! Get the number of worker threads
+        /*!
+            \return Number of threads; zero means the OpenMP default
+        */
+        size_t get_num_threads() const
+        {
+            return m_num_threads;
+        }
+
+        //! Set the number of worker threads
+        /*!
+            Without OpenMP, there is always one worker and this value is ignored.
+            \param a_num_threads - Number of threads; zero selects the OpenMP default
+        */
+        void set_num_threads(size_t a_num_threads)
+        {
+            m_num_threads = a_num_threads;
+        }
+
+        //! Get the replacement policy
+        replacement_policy get_policy() const
+        {
+            return m_policy;
+        }
+
+        //! Set the replacement policy
+        /*!
+            \param a_policy - How children choose the organisms they replace
+            \param a_tournament_size - Number of organisms in a replacement tournament
+        */
+        void set_policy(replacement_policy a_policy, size_t a_tournament_size = 2)
+        {
+            m_policy = a_policy;
+            m_tournament_size = (a_tournament_size > 0) ? a_tournament_size : 1;
+        }
+
+        //! Directly view population
+        /*! <b>Use with caution!</b> Must not be called while the engine runs.
+            \return A reference to the population
+        */
+        vector<OrganismType> & get_population()
+        {
+            return m_population;
+        }
+
+    private:
+        // no copying
+        steady_state(const steady_state & a_source);
+        steady_state & operator = (const steady_state & a_source);
+
+        // workers' random streams start here, clear of those used by other engines
+        static const uint64_t STEADY_STREAM_BASE = uint64_t(2) << 32;
+
+        // snapshots taken per epoch
+        static const size_t SNAPSHOTS_PER_EPOCH = 4;
+
+        // a worker's loop
+        void work(size_t a_target)
+        {
+            vector<OrganismType> children;
+            std::shared_ptr< const vector<OrganismType> > parents;
+            size_t count;
+
+            while (true)
+            {
+                // claim a batch of children, and the population to breed them from
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+
+                    if (m_stop || (m_issued >= a_target))
+                        break;
+
+                    count = std::min(m_batch, a_target - m_issued);
+                    m_issued += count;
+                    parents = m_snapshot;
+                }
+
+                // breed, mutate and test them without holding the lock
+                if (!m_reproducer.breed(*parents, count, children))
+                    children = m_reproducer.breed(*parents, count);
+
+                parents.reset();
+
+                m_mutator.mutate(children);
+
+                for (size_t n = 0; n < children.size(); ++n)
+                    children[n].fitness = m_landscape.test(children[n]);
+
+                // put them in the population
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+
+                    for (size_t n = 0; n < children.size(); ++n)
+                    {
+                        m_population[choose_victim()] = std::move(children[n]);
+                        ++m_evaluations;
+
+                        if (--m_until_refresh == 0)
+                            refresh();
+
+                        if ((m_evaluations % m_population.size()) == 0)
+                            end_epoch();
+                    }
+                }
+
+                children.clear();
+            }
+        }
+
+        // take a new snapshot of the population, and the victims to go with it;
+        // the lock must be held, or the workers not running
+        void refresh()
+        {
+            size_t size = m_population.size();
+
+            m_until_refresh = std::max(size / SNAPSHOTS_PER_EPOCH, size_t(1));
+            m_snapshot = std::make_shared< const vector<OrganismType> >(m_population);
+
+            if (m_policy == REPLACE_WORST)
+            {
+                // the least fit come first; children inserted before the next
+                // refresh are never among them
+                m_victims.resize(size);
+
+                for (size_t n = 0; n < size; ++n)
+                    m_victims[n] = n;
+
+                std::partial_sort(m_victims.begin(), m_victims.begin() + m_until_refresh, m_victims.end(), less_fit(*m_snapshot));
+                m_victims.resize(m_until_refresh);
+                m_next_victim = 0;
+            }
+        }
+
+        // orders organisms from least to most fit
+        struct less_fit
+        {
+            const vector<OrganismType> & m_population;
+
+            less_fit(const vector<OrganismType> & a_population)
+              : m_population(a_population)
+            {
+                // nada
+            }
+
+            bool operator () (size_t a_left, size_t a_right) const
+            {
+                return m_population[a_left].fitness < m_population[a_right].fitness;
+            }
+        };
+
+        // report an epoch; the lock must be held
+        void end_epoch()
+        {
+            ++m_epoch;
+
+            // the listener and analyzer share one set of statistics
+            generation_context<OrganismType> context(m_population, m_epoch);
+
+            m_listener.ping_generation_end(context);
+
+            if (!m_stop && !m_analyzer.analyze(context))
+            {
+                m_stop = true;
+                m_listener.run_complete(m_population);
+            }
+        }
+
+        // pick the organism a child replaces; the lock must be held
+        size_t choose_victim()
+        {
+            size_t victim = 0;
+
+            if (m_policy == REPLACE_WORST)
+                victim = m_victims[m_next_victim++];
+            else
+            {
+                victim = g_random.get_index(m_population.size());
+
+                for (size_t t = 1; t < m_tournament_size; ++t)
+                {
+                    size_t contender = g_random.get_index(m_population.size());
+
+                    if (m_population[contender].fitness < m_population[victim].fitness)
+                        victim = contender;
+                }
+            }
+
+            return victim;
+        }
+
+        // the population being evolved
+        vector<OrganismType> & m_population;
+
+        // tests organisms
+        landscape<OrganismType> & m_landscape;
+
+        // mutates children
+        mutator<OrganismType> & m_mutator;
+
+        // breeds children
+        reproducer<OrganismType> & m_reproducer;
+
+        // decides when to stop
+        analyzer<OrganismType> & m_analyzer;
+
+        // hears about progress
+        listener<OrganismType> & m_listener;
+
+        // how victims are chosen
+        replacement_policy m_policy;
+
+        // organisms in a replacement tournament
+        size_t m_tournament_size;
+
+        // children bred per lock; zero for automatic
+        size_t m_batch_size;
+
+        // children bred per lock in the current run
+        size_t m_batch;
+
+        // worker threads; zero for the OpenMP default
+        size_t m_num_threads;
+
+        // has the initial population been tested?
+        bool m_tested;
+
+        // children tested and inserted
+        size_t m_evaluations;
+
+        // children claimed by workers in the current run
+        size_t m_issued;
+
+        // completed epochs
+        size_t m_epoch;
+
+        // number of calls to run, used to give each run fresh random streams
+        uint64_t m_runs;
+
+        // set when the analyzer ends the run
+        std::atomic<bool> m_stop;
+
+        // guards the population, counters, snapshot and victims
+        std::mutex m_mutex;
+
+        // the population as of the last refresh, which workers breed from
+        std::shared_ptr< const vector<OrganismType> > m_snapshot;
+
+        // least-fit organisms of the snapshot, in the order children replace them
+        vector<size_t> m_victims;
+
+        // next entry of m_victims to be replaced
+        size_t m_next_victim;
+
+        // insertions left before the next refresh
+        size_t m_until_refresh;
+    };
+};
+
+#endif
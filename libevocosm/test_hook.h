@@ -0,0 +1,102 @@
+/*
+    Evocosm is a C++ framework for implementing evolutionary algorithms.
+
+    Copyright 2011 Scott Robert Ladd. All rights reserved.
+
+    Evocosm is user-supported open source software. Its continued development is dependent
+    on financial support from the community. You can provide funding by visiting the Evocosm
+    website at:
+
+        http://www.coyotegulch.com
+
+    You may license Evocosm in one of two fashions:
+
+    1) Simplified BSD License (FreeBSD License)
+
+    Redistribution and use in source and binary forms, with or without modification, are
+    permitted provided that the following conditions are met:
+
+    1.  Redistributions of source code must retain the above copyright notice, this list of
+        conditions and the following disclaimer.
+
+    2.  Redistributions in binary form must reproduce the above copyright notice, this list
+        of conditions and the following disclaimer in the documentation and/or other materials
+        provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY SCOTT ROBERT LADD ``AS IS'' AND ANY EXPRESS OR IMPLIED
+    WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+    FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SCOTT ROBERT LADD OR
+    CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+    ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+    The views and conclusions contained in the software and documentation are those of the
+    authors and should not be interpreted as representing official policies, either expressed
+    or implied, of Scott Robert Ladd.
+
+    2) Closed-Source Proprietary License
+
+    If your project is a closed-source or proprietary project, the Simplified BSD License may
+    not be appropriate or desirable. In such cases, contact the Evocosm copyright holder to
+    arrange your purchase of an appropriate license.
+
+    The author can be contacted at:
+
+          scott.ladd@coyotegulch.com
+          scott.ladd@gmail.com
+          http:www.coyotegulch.com
+*/
+
+#if !defined(LIBEVOCOSM_TEST_HOOK_H)
+#define LIBEVOCOSM_TEST_HOOK_H
+
+// Standard C++ Library
+#include <cstddef>
+#include <vector>
+
+namespace libevocosm
+{
+    using std::vector;
+
+    //! An abstract interface for working on a freshly-tested population
+    /*!
+        An evocosm invokes its test hook once per generation, after the
+        landscape has tested the population and before anything else looks
+        at it. At that point every organism holds the raw fitness its test
+        produced; scaling, selection and breeding have not yet happened. A
+        hook may change the population -- an island_model exchanges organisms
+        between islands here -- and the generation's statistics, analysis,
+        scaling and selection then see the result.
+        \param OrganismType - The type of organism
+    */
+    template <class OrganismType>
+    class test_hook
+    {
+    public:
+        //! Virtual destructor
+        /*!
+            A virtual destructor. By default, it does nothing; this is
+            a placeholder that identifies this class as a potential base,
+            ensuring that objects of a derived class will have their
+            destructors called if they are destroyed through a base-class
+            pointer.
+        */
+        virtual ~test_hook()
+        {
+            // nada
+        }
+
+        //! Population tested
+        /*!
+            Called after a population has been tested.
+            \param a_population - The tested population
+            \param a_iteration - One-based number of the generation
+        */
+        virtual void tested(vector<OrganismType> & a_population, size_t a_iteration) = 0;
+    };
+};
+
+#endif
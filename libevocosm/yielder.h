@@ -0,0 +1,166 @@
+/*
+    Evocosm is a C++ framework for implementing evolutionary algorithms.
+
+    Copyright 2011 Scott Robert Ladd. All rights reserved.
+
+    Evocosm is user-supported open source software. Its continued development is dependent
+    on financial support from the community. You can provide funding by visiting the Evocosm
+    website at:
+
+        http://www.coyotegulch.com
+
+    You may license Evocosm in one of two fashions:
+
+    1) Simplified BSD License (FreeBSD License)
+
+    Redistribution and use in source and binary forms, with or without modification, are
+    permitted provided that the following conditions are met:
+
+    1.  Redistributions of source code must retain the above copyright notice, this list of
+        conditions and the following disclaimer.
+
+    2.  Redistributions in binary form must reproduce the above copyright notice, this list
+        of conditions and the following disclaimer in the documentation and/or other materials
+        provided with the distribution.
+
+    THIS SOFTWARE IS PROVIDED BY SCOTT ROBERT LADD ``AS IS'' AND ANY EXPRESS OR IMPLIED
+    WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+    FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL SCOTT ROBERT LADD OR
+    CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+    CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+    SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+    ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+    ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+    The views and conclusions contained in the software and documentation are those of the
+    authors and should not be interpreted as representing official policies, either expressed
+    or implied, of Scott Robert Ladd.
+
+    2) Closed-Source Proprietary License
+
+    If your project is a closed-source or proprietary project, the Simplified BSD License may
+    not be appropriate or desirable. In such cases, contact the Evocosm copyright holder to
+    arrange your purchase of an appropriate license.
+
+    The author can be contacted at:
+
+          scott.ladd@coyotegulch.com
+          scott.ladd@gmail.com
+          http:www.coyotegulch.com
+*/
+
+#if !defined(LIBEVOCOSM_YIELDER_H)
+#define LIBEVOCOSM_YIELDER_H
+
+#if defined(_MSC_VER)
+#include "windows.h"
+#undef max
+#undef min
+#else
+#include <unistd.h>
+#endif
+
+// Standard C++ Library
+#include <thread>
+
+namespace libevocosm
+{
+    //! An abstract interface for giving up the processor
+    /*!
+        An evocosm periodically offers other work a chance to run by invoking a
+        yielder. What "yielding" means depends on where the evocosm lives: a
+        command-line program may not need to yield at all, a program sharing a
+        machine might hand the processor to other threads, and an application
+        with an event loop might process pending events.
+    */
+    class yielder
+    {
+    public:
+        //! Virtual destructor
+        /*!
+            A virtual destructor. By default, it does nothing; this is
+            a placeholder that identifies this class as a potential base,
+            ensuring that objects of a derived class will have their
+            destructors called if they are destroyed through a base-class
+            pointer.
+        */
+        virtual ~yielder()
+        {
+            // nada
+        }
+
+        //! Yield
+        /*!
+            Lets other work run; returns when the evocosm should continue.
+        */
+        virtual void yield() = 0;
+    };
+
+    //! A yielder that never gives up the processor
+    /*!
+        The null_yielder returns immediately; it is a placeholder for programs
+        that have nothing else to do.
+    */
+    class null_yielder : public yielder
+    {
+    public:
+        //! Do-nothing yield
+        virtual void yield()
+        {
+            // nada
+        }
+    };
+
+    //! A yielder that defers to other runnable threads
+    /*!
+        The thread_yielder asks the operating system to run any other thread that
+        is waiting for the processor. If no other thread is waiting, it returns at
+        once, so an idle machine loses no time to sleeping.
+    */
+    class thread_yielder : public yielder
+    {
+    public:
+        //! Yield to other threads
+        virtual void yield()
+        {
+            std::this_thread::yield();
+        }
+    };
+
+    //! A yielder that sleeps
+    /*!
+        The sleep_yielder suspends the calling thread for a fixed time, whether or
+        not anything else wants to run.
+    */
+    class sleep_yielder : public yielder
+    {
+    public:
+        //! Constructor
+        /*!
+            Creates a new sleep_yielder.
+            \param a_sleep_time - Time to sleep (microseconds)
+        */
+        sleep_yielder(unsigned int a_sleep_time)
+          : m_sleep_time(a_sleep_time)
+        {
+            // nada
+        }
+
+        //! Sleep
+        virtual void yield()
+        {
+          #if defined(_MSC_VER)
+            Sleep(m_sleep_time / 1000);
+          #else
+            usleep((useconds_t)m_sleep_time);
+          #endif
+        }
+
+    private:
+        // microseconds to sleep
+        unsigned int m_sleep_time;
+    };
+};
+
+#endif